@@ -0,0 +1,295 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <cmath>
+
+#include "AVCapture.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AVCapture::~AVCapture()
+{
+  stop();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool AVCapture::start(const string& basename, VideoFormat format,
+                      uInt32 width, uInt32 height, double frameRate,
+                      const PaletteArray& palette, uInt32 sampleRate, bool isStereo)
+{
+  stop();
+
+  myVideoFormat = format;
+  myWidth = width;
+  myHeight = height;
+  mySampleRate = sampleRate;
+  myIsStereo = isStereo;
+  myFrames = myAudioSamples = myAudioBytes = 0;
+  myWriteError = false;
+
+  const auto mode = std::ios_base::binary | std::ios_base::trunc;
+  myVideoFile.open(basename + (format == VideoFormat::y4m ? ".y4m" : ".raw"), mode);
+  myAudioFile.open(basename + ".wav", mode);
+  if(!myVideoFile.is_open() || !myAudioFile.is_open())
+  {
+    myVideoFile.close();
+    myAudioFile.close();
+    return false;
+  }
+
+  if(format == VideoFormat::y4m)
+  {
+    // TIA pixels are twice as wide as they are high
+    myVideoFile << "YUV4MPEG2 W" << width << " H" << height
+                << " F" << std::lround(frameRate * 1000) << ":1000"
+                << " Ip A2:1 C444\n";
+
+    for(uInt32 i = 0; i < kColor; ++i)
+    {
+      const double r = (palette[i] >> 16) & 0xff,
+                   g = (palette[i] >> 8) & 0xff,
+                   b = palette[i] & 0xff;
+
+      myPaletteY[i] = uInt8(std::lround( 16 + ( 65.738 * r + 129.057 * g +  25.064 * b) / 256));
+      myPaletteU[i] = uInt8(std::lround(128 + (-37.945 * r -  74.494 * g + 112.439 * b) / 256));
+      myPaletteV[i] = uInt8(std::lround(128 + (112.439 * r -  94.154 * g -  18.285 * b) / 256));
+    }
+  }
+  else
+  {
+    ofstream paletteFile(basename + ".pal", mode);
+    for(uInt32 i = 0; i < kColor; ++i)
+      paletteFile << char(palette[i] >> 16) << char(palette[i] >> 8) << char(palette[i]);
+
+    if(!paletteFile)
+    {
+      myVideoFile.close();
+      myAudioFile.close();
+      return false;
+    }
+  }
+
+  // The sizes are filled in once the capture is stopped
+  writeWavHeader(0);
+
+  myVideoChunk = make_unique<Chunk>();
+  myVideoChunk->data.reserve(VIDEO_CHUNK_FRAMES * myWidth * myHeight);
+  myAudioChunk = make_unique<Chunk>();
+  myAudioChunk->isVideo = false;
+  myAudioChunk->data.reserve(AUDIO_CHUNK_SIZE);
+
+  myStopWriter = false;
+  myWriterThread = std::thread(&AVCapture::writeChunks, this);
+  myIsRunning = true;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool AVCapture::stop()
+{
+  if(!myIsRunning)
+    return true;
+
+  myIsRunning = false;
+
+  // Write out whatever is left over
+  if(!myVideoChunk->data.empty())  queueChunk(myVideoChunk);
+  if(!myAudioChunk->data.empty())  queueChunk(myAudioChunk);
+
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myStopWriter = true;
+  }
+  myCondition.notify_all();
+  myWriterThread.join();
+
+  myVideoChunk.reset();
+  myAudioChunk.reset();
+
+  // Now that the size of the audio data is known, fix the WAV header
+  myAudioFile.seekp(0);
+  writeWavHeader(uInt32(std::min<uInt64>(myAudioBytes, 0xffffffff - 36)));
+
+  const bool ok = !myWriteError && myVideoFile.good() && myAudioFile.good();
+  myVideoFile.close();
+  myAudioFile.close();
+
+  return ok;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::addFrame(const uInt8* frameBuffer)
+{
+  if(!myIsRunning)
+    return;
+
+  vector<uInt8>& data = myVideoChunk->data;
+  data.insert(data.end(), frameBuffer, frameBuffer + myWidth * myHeight);
+  ++myFrames;
+
+  if(data.size() >= VIDEO_CHUNK_FRAMES * myWidth * myHeight)
+    queueChunk(myVideoChunk);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::addAudio(const Int16* samples, uInt32 count)
+{
+  if(!myIsRunning)
+    return;
+
+  // WAV files are always little endian
+  vector<uInt8>& data = myAudioChunk->data;
+  for(uInt32 i = 0; i < count; ++i)
+  {
+    data.push_back(uInt8(samples[i]));
+    data.push_back(uInt8(uInt16(samples[i]) >> 8));
+  }
+  myAudioSamples += count;
+  myAudioBytes += 2 * count;
+
+  if(data.size() >= AUDIO_CHUNK_SIZE)
+    queueChunk(myAudioChunk);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AVCapture::VideoFormat AVCapture::toVideoFormat(const string& format)
+{
+  return BSPF::equalsIgnoreCase(format, "raw") ? VideoFormat::raw : VideoFormat::y4m;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::queueChunk(unique_ptr<Chunk>& chunk)
+{
+  const bool isVideo = chunk->isVideo;
+  const size_t capacity = chunk->data.capacity();
+
+  {
+    std::unique_lock<std::mutex> lock(myMutex);
+
+    // Wait for the writer to catch up, rather than losing any data
+    myCondition.wait(lock,
+      [this]() { return myPendingChunks.size() < MAX_PENDING_CHUNKS; });
+
+    myPendingChunks.push_back(std::move(chunk));
+  }
+  myCondition.notify_all();
+
+  chunk = make_unique<Chunk>();
+  chunk->isVideo = isVideo;
+  chunk->data.reserve(capacity);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::writeChunks()
+{
+  for(;;)
+  {
+    unique_ptr<Chunk> chunk;
+    {
+      std::unique_lock<std::mutex> lock(myMutex);
+      myCondition.wait(lock,
+        [this]() { return myStopWriter || !myPendingChunks.empty(); });
+
+      // Only quit once all pending chunks have been written
+      if(myPendingChunks.empty())
+        return;
+
+      chunk = std::move(myPendingChunks.front());
+      myPendingChunks.pop_front();
+    }
+    myCondition.notify_all();
+
+    if(chunk->isVideo)
+      writeVideo(*chunk);
+    else
+      myAudioFile.write(reinterpret_cast<const char*>(chunk->data.data()),
+                        chunk->data.size());
+
+    if(!myVideoFile || !myAudioFile)
+    {
+      std::lock_guard<std::mutex> lock(myMutex);
+      myWriteError = true;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::writeVideo(const Chunk& chunk)
+{
+  if(myVideoFormat == VideoFormat::raw)
+  {
+    myVideoFile.write(reinterpret_cast<const char*>(chunk.data.data()),
+                      chunk.data.size());
+    return;
+  }
+
+  // Convert all frames to planar YUV 4:4:4, and write them in one go
+  static constexpr char FRAME_HEADER[] = "FRAME\n";
+  static constexpr size_t FRAME_HEADER_SIZE = sizeof(FRAME_HEADER) - 1;
+
+  const size_t frameSize = size_t(myWidth) * myHeight;
+  const size_t frames = chunk.data.size() / frameSize;
+  myConversionBuffer.resize(frames * (FRAME_HEADER_SIZE + 3 * frameSize));
+
+  uInt8* out = myConversionBuffer.data();
+  for(size_t frame = 0; frame < frames; ++frame)
+  {
+    const uInt8* in = chunk.data.data() + frame * frameSize;
+
+    std::copy_n(FRAME_HEADER, FRAME_HEADER_SIZE, out);
+    out += FRAME_HEADER_SIZE;
+
+    for(size_t i = 0; i < frameSize; ++i)
+    {
+      out[i]                 = myPaletteY[in[i]];
+      out[i + frameSize]     = myPaletteU[in[i]];
+      out[i + 2 * frameSize] = myPaletteV[in[i]];
+    }
+    out += 3 * frameSize;
+  }
+
+  myVideoFile.write(reinterpret_cast<const char*>(myConversionBuffer.data()),
+                    myConversionBuffer.size());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::writeWavHeader(uInt32 dataSize)
+{
+  const uInt16 channels = myIsStereo ? 2 : 1;
+  const uInt32 byteRate = mySampleRate * channels * 2;
+
+  auto put16 = [this](uInt16 value) {
+    myAudioFile.put(char(value)).put(char(value >> 8));
+  };
+  auto put32 = [this](uInt32 value) {
+    myAudioFile.put(char(value)).put(char(value >> 8))
+               .put(char(value >> 16)).put(char(value >> 24));
+  };
+
+  myAudioFile.write("RIFF", 4);
+  put32(36 + dataSize);
+  myAudioFile.write("WAVEfmt ", 8);
+  put32(16);                    // size of the format chunk
+  put16(1);                     // PCM
+  put16(channels);
+  put32(mySampleRate);
+  put32(byteRate);
+  put16(channels * 2);          // block align
+  put16(16);                    // bits per sample
+  myAudioFile.write("data", 4);
+  put32(dataSize);
+}
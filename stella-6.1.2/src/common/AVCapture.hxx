@@ -0,0 +1,187 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef AV_CAPTURE_HXX
+#define AV_CAPTURE_HXX
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "bspf.hxx"
+#include "FrameBufferConstants.hxx"
+
+/**
+  This class records the emulated video and audio output losslessly.  Video
+  is written as a YUV4MPEG2 stream (or as raw 8-bit palette indices plus a
+  palette file), audio as a 16-bit PCM WAV file.
+
+  Frames and audio samples are handed over by the emulation core (typically
+  on the emulation thread) and collected into large chunks, which are then
+  converted and written to disk by a dedicated writer thread.  Frames are
+  never dropped; if the writer can't keep up, the emulation core is stalled
+  instead.  This makes the capture exact, and allows for running faster than
+  realtime (e.g. from the ProfilingRunner).
+*/
+class AVCapture
+{
+  public:
+    enum class VideoFormat { y4m, raw };
+
+  public:
+    AVCapture() = default;
+    ~AVCapture();
+
+    /**
+      Start a new capture, writing '<basename>.y4m' (or '<basename>.raw'
+      and '<basename>.pal') and '<basename>.wav'.
+
+      @param basename    The path and name of the files, without extension
+      @param format      The format of the video file
+      @param width       The width of each frame (in pixels)
+      @param height      The height of each frame (in scanlines)
+      @param frameRate   The (nominal) frame rate of the video
+      @param palette     The palette (0xRRGGBB) for the 8-bit frame data
+      @param sampleRate  The sample rate of the audio
+      @param isStereo    Whether audio samples are stereo or mono
+
+      @return  False if the files couldn't be created, else true
+    */
+    bool start(const string& basename, VideoFormat format,
+               uInt32 width, uInt32 height, double frameRate,
+               const PaletteArray& palette, uInt32 sampleRate, bool isStereo);
+
+    /**
+      Stop the capture, after all pending data has been written.
+
+      @return  False if there were errors writing the files, else true
+    */
+    bool stop();
+
+    /**
+      Add a frame of 8-bit palette indices (width * height bytes).
+    */
+    void addFrame(const uInt8* frameBuffer);
+
+    /**
+      Add audio samples.
+
+      @param samples  The samples (interleaved if stereo)
+      @param count    The number of samples (counting each channel)
+    */
+    void addAudio(const Int16* samples, uInt32 count);
+
+    /**
+      Answer whether a capture is running.
+    */
+    bool isRunning() const { return myIsRunning; }
+
+    /**
+      Answer whether the audio being captured is in stereo.
+    */
+    bool isStereo() const { return myIsStereo; }
+
+    /**
+      The number of frames and audio samples (per channel) captured so far.
+    */
+    uInt64 frames() const { return myFrames; }
+    uInt64 audioSamples() const { return myAudioSamples / (myIsStereo ? 2 : 1); }
+
+    /**
+      Convert the given string ('y4m' or 'raw') into a video format.
+    */
+    static VideoFormat toVideoFormat(const string& format);
+
+  private:
+    struct Chunk {
+      bool isVideo{true};
+      vector<uInt8> data;
+    };
+
+    // The number of frames collected before they're handed to the writer
+    static constexpr uInt32 VIDEO_CHUNK_FRAMES = 32;
+
+    // The number of audio bytes collected before they're handed to the writer
+    static constexpr uInt32 AUDIO_CHUNK_SIZE = 128 * 1024;
+
+    // The number of chunks that may wait for the writer before the emulation
+    // core is stalled
+    static constexpr uInt32 MAX_PENDING_CHUNKS = 16;
+
+  private:
+    /**
+      Hand the given chunk over to the writer thread, and replace it with a
+      new one.
+    */
+    void queueChunk(unique_ptr<Chunk>& chunk);
+
+    /**
+      The main loop of the writer thread.
+    */
+    void writeChunks();
+
+    /**
+      Write a chunk of frames to the video file.
+    */
+    void writeVideo(const Chunk& chunk);
+
+    /**
+      Write the WAV file header for the given number of data bytes.
+    */
+    void writeWavHeader(uInt32 dataSize);
+
+  private:
+    VideoFormat myVideoFormat{VideoFormat::y4m};
+    uInt32 myWidth{0}, myHeight{0};
+    uInt32 mySampleRate{0};
+    bool myIsStereo{false};
+    bool myIsRunning{false};
+
+    ofstream myVideoFile, myAudioFile;
+
+    // Palette converted to YUV (Rec. 601), used for Y4M output
+    std::array<uInt8, kColor> myPaletteY, myPaletteU, myPaletteV;
+
+    // The chunks which are currently being filled
+    unique_ptr<Chunk> myVideoChunk, myAudioChunk;
+
+    // Chunks waiting for the writer thread
+    std::deque<unique_ptr<Chunk>> myPendingChunks;
+    std::mutex myMutex;
+    std::condition_variable myCondition;
+    std::thread myWriterThread;
+    bool myStopWriter{false};
+    bool myWriteError{false};
+
+    // Used by the writer thread for converting frames
+    vector<uInt8> myConversionBuffer;
+
+    // Statistics
+    uInt64 myFrames{0};
+    uInt64 myAudioSamples{0};
+    uInt64 myAudioBytes{0};
+
+  private:
+    // Following constructors and assignment operators not supported
+    AVCapture(const AVCapture&) = delete;
+    AVCapture(AVCapture&&) = delete;
+    AVCapture& operator=(const AVCapture&) = delete;
+    AVCapture& operator=(AVCapture&&) = delete;
+};
+
+#endif // AV_CAPTURE_HXX
@@ -83,6 +83,8 @@ Int16* AudioQueue::enqueue(Int16* fragment)
     return newFragment;
   }
 
+  if (myFragmentTap) myFragmentTap(fragment, myFragmentSize * (myIsStereo ? 2 : 1));
+
   const uInt8 capacity = uInt8(myFragmentQueue.size());
   const uInt8 fragmentIndex = (myNextFragment + mySize) % capacity;
 
@@ -138,3 +140,11 @@ void AudioQueue::ignoreOverflows(bool shouldIgnoreOverflows)
 {
   myIgnoreOverflows = shouldIgnoreOverflows;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AudioQueue::setFragmentTap(const FragmentTap& tap)
+{
+  lock_guard<mutex> guard(myMutex);
+
+  myFragmentTap = tap;
+}
@@ -18,6 +18,7 @@
 #ifndef AUDIO_QUEUE_HXX
 #define AUDIO_QUEUE_HXX
 
+#include <functional>
 #include <mutex>
 
 #include "bspf.hxx"
@@ -36,6 +37,9 @@
 */
 class AudioQueue
 {
+  public:
+    using FragmentTap = std::function<void(const Int16* fragment, uInt32 size)>;
+
   public:
 
     /**
@@ -96,6 +100,14 @@ class AudioQueue
      */
     void ignoreOverflows(bool shouldIgnoreOverflows);
 
+    /**
+      Set a callback which receives every fragment as it is enqueued, independent
+      of playback (used for capturing). The fragment is only valid during the call.
+
+      @param tap  The callback (size is the number of Int16 values), or nullptr
+    */
+    void setFragmentTap(const FragmentTap& tap);
+
   private:
 
     // The size of an individual fragment (in stereo / mono samples)
@@ -132,6 +144,9 @@ class AudioQueue
 
     StaggeredLogger myOverflowLogger{"audio buffer overflow", Logger::Level::INFO};
 
+    // Receives all enqueued fragments
+    FragmentTap myFragmentTap;
+
   private:
 
     AudioQueue() = delete;
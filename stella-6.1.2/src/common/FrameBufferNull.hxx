@@ -0,0 +1,90 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef FRAMEBUFFER_NULL_HXX
+#define FRAMEBUFFER_NULL_HXX
+
+class OSystem;
+
+#include "bspf.hxx"
+#include "FrameBuffer.hxx"
+#include "FBSurface.hxx"
+
+/**
+  This class implements a Null framebuffer, which never opens a display.
+  It is used when emulating without any output (ie, when running scripts),
+  where messages meant for the screen are silently dropped.
+
+  Since it never creates any surfaces, it must not be initialized.
+*/
+class FrameBufferNull : public FrameBuffer
+{
+  public:
+    /**
+      Creates a new Null framebuffer
+    */
+    explicit FrameBufferNull(OSystem& osystem) : FrameBuffer(osystem) { }
+    virtual ~FrameBufferNull() = default;
+
+    //////////////////////////////////////////////////////////////////////
+    // The following are derived from public methods in FrameBuffer.hxx
+    //////////////////////////////////////////////////////////////////////
+
+    void setTitle(const string& title) override { }
+    void showCursor(bool show) override { }
+    bool fullScreen() const override { return false; }
+    void getRGB(uInt32 pixel, uInt8* r, uInt8* g, uInt8* b) const override {
+      *r = uInt8(pixel >> 16);  *g = uInt8(pixel >> 8);  *b = uInt8(pixel);
+    }
+    uInt32 mapRGB(uInt8 r, uInt8 g, uInt8 b) const override {
+      return (r << 16) | (g << 8) | b;
+    }
+    void readPixels(uInt8* buffer, uInt32 pitch, const Common::Rect& rect) const override { }
+    Int32 getCurrentDisplayIndex() override { return -1; }
+    void updateWindowedPos() override { }
+    void clear() override { }
+
+  protected:
+    //////////////////////////////////////////////////////////////////////
+    // The following are derived from protected methods in FrameBuffer.hxx
+    //////////////////////////////////////////////////////////////////////
+
+    void queryHardware(vector<Common::Size>& fullscreenRes,
+                       vector<Common::Size>& windowedRes,
+                       VariantList& renderers) override { }
+    bool setVideoMode(const string& title, const VideoMode& mode) override {
+      return false;
+    }
+    unique_ptr<FBSurface> createSurface(uInt32 w, uInt32 h,
+        FrameBuffer::ScalingInterpolation, const uInt32* data) const override {
+      return nullptr;
+    }
+    void grabMouse(bool grab) override { }
+    void setWindowIcon() override { }
+    void renderToScreen() override { }
+    string about() const override { return "Video disabled"; }
+
+  private:
+    // Following constructors and assignment operators not supported
+    FrameBufferNull() = delete;
+    FrameBufferNull(const FrameBufferNull&) = delete;
+    FrameBufferNull(FrameBufferNull&&) = delete;
+    FrameBufferNull& operator=(const FrameBufferNull&) = delete;
+    FrameBufferNull& operator=(FrameBufferNull&&) = delete;
+};
+
+#endif
@@ -450,6 +450,7 @@ PhysicalKeyboardHandler::EventMappingArray PhysicalKeyboardHandler::DefaultCommo
   {Event::LoadAllStates,            KBDK_F11, MOD3},
   {Event::TakeSnapshot,             KBDK_F12},
   {Event::TogglePauseMode,          KBDK_PAUSE},
+  {Event::ToggleTurbo,              KBDK_T, KBDM_CTRL},
   {Event::OptionsMenuMode,          KBDK_TAB},
   {Event::CmdMenuMode,              KBDK_BACKSLASH},
   {Event::TimeMachineMode,          KBDK_T, KBDM_SHIFT},
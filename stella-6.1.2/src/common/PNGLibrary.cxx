@@ -27,6 +27,7 @@
 #include "Props.hxx"
 #include "Settings.hxx"
 #include "TIASurface.hxx"
+#include "TIA.hxx"
 #include "Version.hxx"
 #include "PNGLibrary.hxx"
 #include "Rect.hxx"
@@ -37,6 +38,12 @@ PNGLibrary::PNGLibrary(OSystem& osystem)
 {
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+PNGLibrary::~PNGLibrary()
+{
+  stopEncoders();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PNGLibrary::loadImage(const string& filename, FBSurface& surface)
 {
@@ -122,36 +129,6 @@ void PNGLibrary::loadImage(const string& filename, FBSurface& surface)
     png_destroy_read_struct(&png_ptr, info_ptr ? &info_ptr : nullptr, nullptr);
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void PNGLibrary::saveImage(const string& filename, const VariantList& comments)
-{
-  ofstream out(filename, std::ios_base::binary);
-  if(!out.is_open())
-    throw runtime_error("ERROR: Couldn't create snapshot file");
-
-  const FrameBuffer& fb = myOSystem.frameBuffer();
-
-  const Common::Rect& rectUnscaled = fb.imageRect();
-  const Common::Rect rect(
-    Common::Point(fb.scaleX(rectUnscaled.x()), fb.scaleY(rectUnscaled.y())),
-    fb.scaleX(rectUnscaled.w()), fb.scaleY(rectUnscaled.h())
-  );
-
-  png_uint_32 width = rect.w(), height = rect.h();
-
-  // Get framebuffer pixel data (we get ABGR format)
-  vector<png_byte> buffer(width * height * 4);
-  fb.readPixels(buffer.data(), width*4, rect);
-
-  // Set up pointers into "buffer" byte array
-  vector<png_bytep> rows(height);
-  for(png_uint_32 k = 0; k < height; ++k)
-    rows[k] = static_cast<png_bytep>(buffer.data() + k*width*4);
-
-  // And save the image
-  saveImageToDisk(out, rows, width, height, comments);
-}
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PNGLibrary::saveImage(const string& filename, const FBSurface& surface,
                            const Common::Rect& rect, const VariantList& comments)
@@ -178,12 +155,14 @@ void PNGLibrary::saveImage(const string& filename, const FBSurface& surface,
     rows[k] = static_cast<png_bytep>(buffer.data() + k*width*4);
 
   // And save the image
-  saveImageToDisk(out, rows, width, height, comments);
+  saveImageToDisk(out, rows, width, height, comments,
+                  myOSystem.settings().getInt("sszlevel"));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PNGLibrary::saveImageToDisk(ofstream& out, const vector<png_bytep>& rows,
-    png_uint_32 width, png_uint_32 height, const VariantList& comments)
+    png_uint_32 width, png_uint_32 height, const VariantList& comments,
+    int zlevel, const vector<png_color>& palette)
 {
   png_structp png_ptr = nullptr;
   png_infop info_ptr = nullptr;
@@ -209,10 +188,22 @@ void PNGLibrary::saveImageToDisk(ofstream& out, const vector<png_bytep>& rows,
   // Set up the output control
   png_set_write_fn(png_ptr, &out, png_write_data, png_io_flush);
 
+  // Lower levels are much faster, at the expense of larger files
+  png_set_compression_level(png_ptr, BSPF::clamp(zlevel, 0, 9));
+
   // Write PNG header info
+  const bool paletted = !palette.empty();
   png_set_IHDR(png_ptr, info_ptr, width, height, 8,
-      PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
+      paletted ? PNG_COLOR_TYPE_PALETTE : PNG_COLOR_TYPE_RGB,
+      PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
       PNG_FILTER_TYPE_DEFAULT);
+  if(paletted)
+  {
+    png_set_PLTE(png_ptr, info_ptr, palette.data(), int(palette.size()));
+
+    // Paletted images don't benefit from filtering
+    png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_NONE);
+  }
 
   // Write comments
   writeComments(png_ptr, info_ptr, comments);
@@ -220,17 +211,20 @@ void PNGLibrary::saveImageToDisk(ofstream& out, const vector<png_bytep>& rows,
   // Write the file header information.  REQUIRED
   png_write_info(png_ptr, info_ptr);
 
-  // Pack pixels into bytes
-  png_set_packing(png_ptr);
+  if(!paletted)
+  {
+    // Pack pixels into bytes
+    png_set_packing(png_ptr);
 
-  // Swap location of alpha bytes from ARGB to RGBA
-  png_set_swap_alpha(png_ptr);
+    // Swap location of alpha bytes from ARGB to RGBA
+    png_set_swap_alpha(png_ptr);
 
-  // Pack ARGB into RGB
-  png_set_filler(png_ptr, 0, PNG_FILLER_AFTER);
+    // Pack ARGB into RGB
+    png_set_filler(png_ptr, 0, PNG_FILLER_AFTER);
 
-  // Flip BGR pixels to RGB
-  png_set_bgr(png_ptr);
+    // Flip BGR pixels to RGB
+    png_set_bgr(png_ptr);
+  }
 
   // Write the entire image in one go
   png_write_image(png_ptr, const_cast<png_bytep*>(rows.data()));
@@ -243,6 +237,167 @@ void PNGLibrary::saveImageToDisk(ofstream& out, const vector<png_bytep>& rows,
     png_destroy_write_struct(&png_ptr, &info_ptr);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::saveSnapshot(const Snapshot& snapshot)
+{
+  ofstream out(snapshot.filename, std::ios_base::binary);
+  if(!out.is_open())
+    throw runtime_error("ERROR: Couldn't create snapshot file");
+
+  // Paletted images use one byte per pixel, RGB images are in ABGR format
+  const png_uint_32 pitch = snapshot.width * (snapshot.palette.empty() ? 4 : 1);
+
+  // Set up pointers into the pixel data
+  vector<png_bytep> rows(snapshot.height);
+  for(png_uint_32 k = 0; k < snapshot.height; ++k)
+    rows[k] = const_cast<png_bytep>(snapshot.pixels.data() + k*pitch);
+
+  // And save the image
+  saveImageToDisk(out, rows, snapshot.width, snapshot.height,
+                  snapshot.comments, snapshot.zlevel, snapshot.palette);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::captureSnapshot(Snapshot& snapshot)
+{
+  FrameBuffer& fb = myOSystem.frameBuffer();
+  const Settings& settings = myOSystem.settings();
+
+  snapshot.zlevel = settings.getInt("sszlevel");
+
+  if(settings.getBool("ss1x"))
+  {
+    if(settings.getBool("ssindexed"))
+    {
+      // Take the image straight from the TIA; since each pixel is already an
+      // index into the current palette, no conversion is necessary
+      TIA& tia = myOSystem.console().tia();
+      snapshot.width = tia.width();
+      snapshot.height = tia.height();
+      const uInt8* buffer = tia.frameBuffer();
+      snapshot.pixels.assign(buffer, buffer + snapshot.width * snapshot.height);
+
+      const PaletteArray& rgbPalette = fb.tiaSurface().rgbPalette();
+      snapshot.palette.resize(rgbPalette.size());
+      for(size_t i = 0; i < rgbPalette.size(); ++i)
+      {
+        snapshot.palette[i].red   = png_byte(rgbPalette[i] >> 16);
+        snapshot.palette[i].green = png_byte(rgbPalette[i] >> 8);
+        snapshot.palette[i].blue  = png_byte(rgbPalette[i]);
+      }
+    }
+    else
+    {
+      Common::Rect rect;
+      const FBSurface& surface = fb.tiaSurface().baseSurface(rect);
+      snapshot.width = rect.w();
+      snapshot.height = rect.h();
+
+      // Get the surface pixel data (we get ABGR format)
+      snapshot.pixels.resize(snapshot.width * snapshot.height * 4);
+      surface.readPixels(snapshot.pixels.data(), snapshot.width, rect);
+    }
+  }
+  else
+  {
+    // Make sure we have a 'clean' image, with no onscreen messages
+    fb.enableMessages(false);
+    fb.tiaSurface().renderForSnapshot();
+
+    const Common::Rect& rectUnscaled = fb.imageRect();
+    const Common::Rect rect(
+      Common::Point(fb.scaleX(rectUnscaled.x()), fb.scaleY(rectUnscaled.y())),
+      fb.scaleX(rectUnscaled.w()), fb.scaleY(rectUnscaled.h())
+    );
+    snapshot.width = rect.w();
+    snapshot.height = rect.h();
+
+    // Get framebuffer pixel data (we get ABGR format)
+    snapshot.pixels.resize(snapshot.width * snapshot.height * 4);
+    fb.readPixels(snapshot.pixels.data(), snapshot.width*4, rect);
+
+    // Re-enable old messages
+    fb.enableMessages(true);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool PNGLibrary::canQueueSnapshot()
+{
+  std::lock_guard<std::mutex> lock(mySnapshotQueueMutex);
+
+  if(myEncoderThreads.empty())
+  {
+    const uInt32 numThreads =
+      BSPF::clamp(std::thread::hardware_concurrency(), 1U, MAX_ENCODER_THREADS);
+
+    myStopEncoders = false;
+    for(uInt32 i = 0; i < numThreads; ++i)
+      myEncoderThreads.emplace_back(&PNGLibrary::encodeSnapshots, this);
+  }
+
+  if(mySnapshotQueue.size() >= SNAPSHOT_QUEUE_SIZE)
+  {
+    ++myDroppedSnapshots;
+    return false;
+  }
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::queueSnapshot(unique_ptr<Snapshot> snapshot)
+{
+  {
+    std::lock_guard<std::mutex> lock(mySnapshotQueueMutex);
+    mySnapshotQueue.push_back(std::move(snapshot));
+  }
+  mySnapshotQueueCondition.notify_one();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::encodeSnapshots()
+{
+  for(;;)
+  {
+    unique_ptr<Snapshot> snapshot;
+    {
+      std::unique_lock<std::mutex> lock(mySnapshotQueueMutex);
+      mySnapshotQueueCondition.wait(lock,
+        [this]() { return myStopEncoders || !mySnapshotQueue.empty(); });
+
+      // Only quit once all pending snapshots have been written
+      if(mySnapshotQueue.empty())
+        return;
+
+      snapshot = std::move(mySnapshotQueue.front());
+      mySnapshotQueue.pop_front();
+    }
+
+    try
+    {
+      saveSnapshot(*snapshot);
+    }
+    catch(const runtime_error&)
+    {
+      ++myFailedSnapshots;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::stopEncoders()
+{
+  {
+    std::lock_guard<std::mutex> lock(mySnapshotQueueMutex);
+    myStopEncoders = true;
+  }
+  mySnapshotQueueCondition.notify_all();
+
+  for(auto& thread: myEncoderThreads)
+    thread.join();
+  myEncoderThreads.clear();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PNGLibrary::updateTime(uInt64 time)
 {
@@ -272,10 +427,20 @@ void PNGLibrary::toggleContinuousSnapshots(bool perFrame)
   }
   else
   {
+    // Make sure all pending snapshots have been written
+    stopEncoders();
+
+    // Not every interval produces a snapshot (e.g. without a console), so
+    // make sure the count can't wrap around
+    const uInt32 taken = mySnapCounter / mySnapInterval,
+                 lost = myDroppedSnapshots + myFailedSnapshots;
     ostringstream buf;
-    buf << "Disabling snapshots, generated "
-      << (mySnapCounter / mySnapInterval)
-      << " files";
+    buf << "Disabling snapshots, generated " << (taken > lost ? taken - lost : 0)
+        << " files";
+    if(myDroppedSnapshots > 0)
+      buf << ", dropped " << myDroppedSnapshots;
+    if(myFailedSnapshots > 0)
+      buf << ", failed " << myFailedSnapshots;
     myOSystem.frameBuffer().showMessage(buf.str());
     setContinuousSnapInterval(0);
   }
@@ -286,6 +451,8 @@ void PNGLibrary::setContinuousSnapInterval(uInt32 interval)
 {
   mySnapInterval = interval;
   mySnapCounter = 0;
+  myDroppedSnapshots = 0;
+  myFailedSnapshots = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -294,9 +461,16 @@ void PNGLibrary::takeSnapshot(uInt32 number)
   if(!myOSystem.hasConsole())
     return;
 
+  // Numbered snapshots are written in the background; if the encoders can't
+  // keep up, skip this one
+  const bool background = number > 0;
+  if(background && !canQueueSnapshot())
+    return;
+
+  auto snapshot = make_unique<Snapshot>();
+
   // Figure out the correct snapshot name
-  string filename;
-  bool showmessage = number == 0;
+  string& filename = snapshot->filename;
   string sspath = myOSystem.snapshotSaveDir() +
       (myOSystem.settings().getString("snapname") != "int" ?
           myOSystem.romFile().getNameWithExt("")
@@ -334,7 +508,7 @@ void PNGLibrary::takeSnapshot(uInt32 number)
     filename = sspath + ".png";
 
   // Some text fields to add to the PNG snapshot
-  VariantList comments;
+  VariantList& comments = snapshot->comments;
   ostringstream version;
   version << "Stella " << STELLA_VERSION << " (Build " << STELLA_BUILD << ") ["
           << BSPF::ARCH << "]";
@@ -344,46 +518,29 @@ void PNGLibrary::takeSnapshot(uInt32 number)
       : myOSystem.romFile().getName();
   VarList::push_back(comments, "ROM Name", name);
   VarList::push_back(comments, "ROM MD5", myOSystem.console().properties().get(PropType::Cart_MD5));
-  VarList::push_back(comments, "TV Effects", myOSystem.frameBuffer().tiaSurface().effectsInfo());
+  VarList::push_back(comments, "TV Effects",
+      myOSystem.settings().getBool("ss1x") && myOSystem.settings().getBool("ssindexed")
+      ? "None (indexed)" : myOSystem.frameBuffer().tiaSurface().effectsInfo());
 
   // Now create a PNG snapshot
-  if(myOSystem.settings().getBool("ss1x"))
+  string message = "Snapshot saved";
+  try
   {
-    string message = "Snapshot saved";
-    try
-    {
-      Common::Rect rect;
-      const FBSurface& surface = myOSystem.frameBuffer().tiaSurface().baseSurface(rect);
-      myOSystem.png().saveImage(filename, surface, rect, comments);
-    }
-    catch(const runtime_error& e)
-    {
-      message = e.what();
-    }
-    if(showmessage)
-      myOSystem.frameBuffer().showMessage(message);
+    captureSnapshot(*snapshot);
+
+    if(background)
+      queueSnapshot(std::move(snapshot));
+    else
+      saveSnapshot(*snapshot);
   }
-  else
+  catch(const runtime_error& e)
   {
-    // Make sure we have a 'clean' image, with no onscreen messages
-    myOSystem.frameBuffer().enableMessages(false);
-    myOSystem.frameBuffer().tiaSurface().renderForSnapshot();
-
-    string message = "Snapshot saved";
-    try
-    {
-      myOSystem.png().saveImage(filename, comments);
-    }
-    catch(const runtime_error& e)
-    {
-      message = e.what();
-    }
-
-    // Re-enable old messages
-    myOSystem.frameBuffer().enableMessages(true);
-    if(showmessage)
-      myOSystem.frameBuffer().showMessage(message);
+    message = e.what();
+    if(background)
+      ++myFailedSnapshots;
   }
+  if(!background)
+    myOSystem.frameBuffer().showMessage(message);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
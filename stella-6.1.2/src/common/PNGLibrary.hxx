@@ -21,6 +21,11 @@
 #define PNGLIBRARY_HXX
 
 #include <png.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 class OSystem;
 class FrameBuffer;
@@ -40,6 +45,7 @@ class PNGLibrary
 {
   public:
     explicit PNGLibrary(OSystem& osystem);
+    ~PNGLibrary();
 
     /**
       Read a PNG image from the specified file into a FBSurface structure,
@@ -54,21 +60,6 @@ class PNGLibrary
     */
     void loadImage(const string& filename, FBSurface& surface);
 
-    /**
-      Save the current FrameBuffer image to a PNG file.  Note that in most
-      cases this will be a TIA image, but it could actually be used for
-      *any* mode.
-
-      @param filename  The filename to save the PNG image
-      @param comments  The text comments to add to the PNG image
-
-      @post  On success, the PNG file has been saved to 'filename',
-             otherwise a runtime_error is thrown containing a
-             more detailed error message.
-    */
-    void saveImage(const string& filename,
-                   const VariantList& comments = EmptyVarList);
-
     /**
       Save the given surface to a PNG file.
 
@@ -122,10 +113,35 @@ class PNGLibrary
       Create a new snapshot based on the name of the ROM, and also
       optionally using the number given as a parameter.
 
+      Numbered snapshots (as used by continuous snapshot mode) are only
+      captured here; they are compressed and written to disk by a pool of
+      encoder threads, so the emulation isn't held up.
+
       @param number  Optional number to append to the snapshot name
     */
     void takeSnapshot(uInt32 number = 0);
 
+  private:
+    /**
+      A snapshot captured from the framebuffer or the TIA, which is ready to
+      be compressed and written to disk.
+    */
+    struct Snapshot {
+      string filename;
+      VariantList comments;
+      png_uint_32 width{0}, height{0};
+      int zlevel{6};              // zlib compression level (0 - 9)
+      vector<png_byte> pixels;    // ABGR, or palette indices if paletted
+      vector<png_color> palette;  // empty for RGB images
+    };
+
+    // Maximum number of snapshots waiting for the encoder threads; further
+    // snapshots are dropped until the encoders have caught up
+    static constexpr size_t SNAPSHOT_QUEUE_SIZE = 16;
+
+    // Maximum number of encoder threads
+    static constexpr uInt32 MAX_ENCODER_THREADS = 4;
+
   private:
     // Global OSystem object
     OSystem& myOSystem;
@@ -134,6 +150,17 @@ class PNGLibrary
     uInt32 mySnapInterval{0};
     uInt32 mySnapCounter{0};
 
+    // Snapshots waiting for the encoder threads
+    std::deque<unique_ptr<Snapshot>> mySnapshotQueue;
+    std::mutex mySnapshotQueueMutex;
+    std::condition_variable mySnapshotQueueCondition;
+    vector<std::thread> myEncoderThreads;
+    bool myStopEncoders{false};
+
+    // Statistics for continuous snapshot mode
+    uInt32 myDroppedSnapshots{0};
+    std::atomic<uInt32> myFailedSnapshots{0};
+
     // The following data remains between invocations of allocateStorage,
     // and is only changed when absolutely necessary.
     struct ReadInfoType {
@@ -160,14 +187,53 @@ class PNGLibrary
     /** The actual method which saves a PNG image.
 
       @param out      The output stream for writing PNG data
-      @param rows     Pointer into PNG RGB data for each row
+      @param rows     Pointer into PNG RGB (or palette index) data for each row
       @param width    The width of the PNG image
       @param height   The height of the PNG image
       @param comments The text comments to add to the PNG image
+      @param zlevel   The zlib compression level (0 - 9)
+      @param palette  The palette for paletted images (empty for RGB)
     */
     void saveImageToDisk(ofstream& out, const vector<png_bytep>& rows,
                          png_uint_32 width, png_uint_32 height,
-                         const VariantList& comments);
+                         const VariantList& comments, int zlevel,
+                         const vector<png_color>& palette = {});
+
+    /**
+      Compress and write the given snapshot to disk.  This is thread-safe,
+      and called from the encoder threads for continuous snapshots.
+    */
+    void saveSnapshot(const Snapshot& snapshot);
+
+    /**
+      Capture the current TIA image into the given snapshot, according to
+      the 'ss1x' and 'ssindexed' settings.
+    */
+    void captureSnapshot(Snapshot& snapshot);
+
+    /**
+      Check whether another snapshot can be handed over to the encoder
+      threads (starting them if necessary).  If too many snapshots are
+      waiting already, the snapshot is counted as dropped.
+
+      @return  False if the snapshot should be dropped, else true
+    */
+    bool canQueueSnapshot();
+
+    /**
+      Hand over the snapshot to the encoder threads.
+    */
+    void queueSnapshot(unique_ptr<Snapshot> snapshot);
+
+    /**
+      The main loop of the encoder threads.
+    */
+    void encodeSnapshots();
+
+    /**
+      Stop the encoder threads, after all queued snapshots have been written.
+    */
+    void stopEncoders();
 
     /**
       Load the PNG data from 'ReadInfo' into the FBSurface.  The surface
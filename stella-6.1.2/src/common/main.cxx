@@ -33,11 +33,13 @@
 #include "System.hxx"
 #include "TIASurface.hxx"
 #include "ProfilingRunner.hxx"
+#include "TimingVerifier.hxx"
 
 #include "ThreadDebugging.hxx"
 
 #ifdef DEBUGGER_SUPPORT
   #include "Debugger.hxx"
+  #include "ScriptRunner.hxx"
 #endif
 
 #ifdef CHEATCODE_SUPPORT
@@ -74,6 +76,18 @@ void checkForCustomBaseDir(Settings::Options& options);
 */
 bool isProfilingRun(int ac, char* av[]);
 
+/**
+  Checks whether the commandline contains an argument corresponding to
+  starting a kernel timing verification.
+*/
+bool isVerifyRun(int ac, char* av[]);
+
+/**
+  Checks whether the commandline contains an argument corresponding to
+  running debugger scripts.
+*/
+bool isScriptRun(int ac, char* av[]);
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void parseCommandLine(int ac, char* av[],
     Settings::Options& globalOpts, Settings::Options& localOpts)
@@ -153,6 +167,20 @@ bool isProfilingRun(int ac, char* av[]) {
   return string(av[1]) == "-profile";
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool isVerifyRun(int ac, char* av[]) {
+  if (ac <= 1) return false;
+
+  return string(av[1]) == "-verify";
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool isScriptRun(int ac, char* av[]) {
+  if (ac <= 1) return false;
+
+  return string(av[1]) == "-script";
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 #if defined(BSPF_MACOS)
 int stellaMain(int ac, char* av[])
@@ -178,6 +206,20 @@ int main(int ac, char* av[])
     }
   }
 
+  if (isVerifyRun(ac, av)) {
+    TimingVerifier verifier(ac, av);
+
+    return verifier.run() ? 0 : 1;
+  }
+
+#ifdef DEBUGGER_SUPPORT
+  if (isScriptRun(ac, av)) {
+    ScriptRunner runner(ac, av);
+
+    return runner.run() ? 0 : 1;
+  }
+#endif
+
   unique_ptr<OSystem> theOSystem;
 
   auto Cleanup = [&theOSystem]() {
@@ -22,6 +22,7 @@ MODULE_OBJS := \
 	src/common/TimerManager.o \
 	src/common/ZipHandler.o \
 	src/common/AudioQueue.o \
+	src/common/AVCapture.o \
 	src/common/AudioSettings.o \
 	src/common/FpsMeter.o \
 	src/common/ThreadDebugging.o \
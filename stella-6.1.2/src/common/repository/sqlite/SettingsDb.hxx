@@ -32,6 +32,8 @@ class SettingsDb
 
     KeyValueRepository& settingsRepository() const { return *mySettingsRepository; }
 
+    KeyValueRepository& detectionRepository() const { return *myDetectionRepository; }
+
   private:
 
     string myDatabaseDirectory;
@@ -39,6 +41,7 @@ class SettingsDb
 
     unique_ptr<SqliteDatabase> myDb;
     unique_ptr<KeyValueRepositorySqlite> mySettingsRepository;
+    unique_ptr<KeyValueRepositorySqlite> myDetectionRepository;
 };
 
 #endif // SETTINGS_DB_HXX
@@ -32,6 +32,7 @@
 #include "CartRamWidget.hxx"
 #include "RomWidget.hxx"
 #include "Base.hxx"
+#include "CodeCoverage.hxx"
 #include "exception/EmulationWarning.hxx"
 
 using Common::Base;
@@ -745,7 +746,7 @@ string CartDebug::loadListFile()
       }
     }
   }
-  myDebugger.rom().invalidate();
+  myDebugger.invalidateRom();
 
   return "list file '" + node.getShortPath() + "' loaded OK";
 }
@@ -805,7 +806,7 @@ string CartDebug::loadSymbolFile()
       }
     }
   }
-  myDebugger.rom().invalidate();
+  myDebugger.invalidateRom();
 
   return "symbol file '" + node.getShortPath() + "' loaded OK";
 }
@@ -901,7 +902,7 @@ string CartDebug::loadConfigFile()
       }
     }
   }
-  myDebugger.rom().invalidate();
+  myDebugger.invalidateRom();
 
   stringstream retVal;
   if(myConsole.cartridge().bankCount() > 1)
@@ -951,6 +952,91 @@ string CartDebug::saveConfigFile()
   return retVal.str();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string CartDebug::coverageFile(const string& file) const
+{
+  if(file == "")
+    return FilesystemNode(myOSystem.defaultSaveDir() +
+      myConsole.properties().get(PropType::Cart_Name) + ".cov").getPath();
+
+  // Plain file names which don't exist are taken from the default save location
+  FilesystemNode node(file);
+  if(!node.exists() && file.find_first_of("/\\") == string::npos)
+    node = FilesystemNode(myOSystem.defaultSaveDir() + file);
+
+  return node.getPath();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string CartDebug::loadCoverage(const StringList& files)
+{
+  size_t size = 0;
+  uInt8* flags = myConsole.cartridge().getCodeAccessBase(size);
+  if(flags == nullptr)
+    return DebuggerParser::red("coverage not supported for this cartridge");
+
+  // Merge all files first, so that an invalid one leaves the flags unchanged
+  CodeCoverage coverage(myConsole.properties().get(PropType::Cart_MD5), size);
+  string name;
+  for(const string& file: files.empty() ? StringList{""} : files)
+  {
+    FilesystemNode node(coverageFile(file));
+    ifstream in(node.getPath(), std::ios::binary);
+    if(!in.is_open())
+      return DebuggerParser::red("coverage file '" + node.getShortPath() + "' not found");
+
+    if(!coverage.load(in))
+      return DebuggerParser::red("'" + node.getShortPath() +
+                                 "' is not a coverage file of this ROM");
+    name = node.getShortPath();
+  }
+
+  coverage.apply(flags);
+  myDebugger.invalidateRom();
+
+  ostringstream buf;
+  if(files.size() > 1)
+    buf << files.size() << " coverage files";
+  else
+    buf << "coverage file '" << name << "'";
+  buf << " loaded OK ("
+      << coverage.count(CODE) << " CODE, " << coverage.count(GFX) << " GFX, "
+      << coverage.count(PGFX) << " PGFX, " << coverage.count(DATA) << " DATA bytes)";
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string CartDebug::saveCoverage(const string& file)
+{
+  size_t size = 0;
+  const uInt8* flags = myConsole.cartridge().getCodeAccessBase(size);
+  if(flags == nullptr)
+    return DebuggerParser::red("coverage not supported for this cartridge");
+
+  CodeCoverage coverage(myConsole.properties().get(PropType::Cart_MD5), size);
+  coverage.snapshot(flags);
+
+  // Accumulate the coverage of all sessions in the same file
+  FilesystemNode node(coverageFile(file));
+  if(node.exists())
+  {
+    ifstream in(node.getPath(), std::ios::binary);
+    if(!coverage.load(in))
+      return DebuggerParser::red("'" + node.getShortPath() +
+                                 "' is not a coverage file of this ROM");
+  }
+
+  ofstream out(node.getPath(), std::ios::binary);
+  if(!out.is_open())
+    return DebuggerParser::red("unable to save coverage to " + node.getShortPath());
+  coverage.save(out);
+
+  ostringstream buf;
+  buf << "coverage file '" << node.getShortPath() << "' saved OK ("
+      << coverage.usedBanks() << " of " << coverage.bankCount() << " banks used)";
+  return buf.str();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string CartDebug::saveDisassembly()
 {
@@ -225,6 +225,18 @@ class CartDebug : public DebuggerSystem
     string loadConfigFile();
     string saveConfigFile();
 
+    /**
+      Load/save code coverage maps (the code and data access flags of all
+      banks); saving merges the current flags into an existing map, loading
+      merges one or more maps into the current flags, so that Distella can
+      use them.  Nothing is merged if any of the maps can't be loaded.
+
+      @param file(s)  The name of the map file(s); an empty name selects the
+                      default name in the default save location
+    */
+    string loadCoverage(const StringList& files);
+    string saveCoverage(const string& file = "");
+
     /**
       Save disassembly and ROM file
     */
@@ -253,6 +265,9 @@ class CartDebug : public DebuggerSystem
     void addressTypeAsString(ostream& buf, uInt16 addr) const;
 
   private:
+    // The path of a coverage map file (see loadCoverage/saveCoverage)
+    string coverageFile(const string& file) const;
+
     using AddrToLabel = std::map<uInt16, string>;
     using LabelToAddr = std::map<string, uInt16,
         std::function<bool(const string&, const string&)>>;
@@ -0,0 +1,167 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "CartDebug.hxx"
+#include "CodeCoverage.hxx"
+
+namespace {
+  // "STLCOV" followed by the format version and the number of bitplanes
+  constexpr std::array<uInt8, 8> HEADER = {
+    'S', 'T', 'L', 'C', 'O', 'V', 1, 4
+  };
+  constexpr uInt32 MD5_SIZE = 32;
+}
+
+const std::array<uInt8, 4> CodeCoverage::FLAGS = {
+  CartDebug::CODE, CartDebug::GFX, CartDebug::PGFX, CartDebug::DATA
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+CodeCoverage::CodeCoverage(const string& md5, size_t size)
+  : myMD5(md5),
+    mySize(uInt32(size)),
+    myBankCount((mySize + BANK_SIZE - 1) / BANK_SIZE),
+    myBits(myBankCount * FLAGS.size() * PLANE_SIZE, 0)
+{
+  myMD5.resize(MD5_SIZE, ' ');
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CodeCoverage::snapshot(const uInt8* flags)
+{
+  for(uInt32 offset = 0; offset < mySize; ++offset)
+  {
+    const uInt8 f = flags[offset];
+    const uInt8 bit = 1 << (offset & 7);
+    const uInt32 bank = offset / BANK_SIZE, idx = (offset % BANK_SIZE) >> 3;
+
+    for(uInt32 p = 0; p < FLAGS.size(); ++p)
+      if(f & FLAGS[p])
+        plane(bank, p)[idx] |= bit;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CodeCoverage::apply(uInt8* flags) const
+{
+  for(uInt32 offset = 0; offset < mySize; ++offset)
+  {
+    const uInt8 bit = 1 << (offset & 7);
+    const uInt32 bank = offset / BANK_SIZE, idx = (offset % BANK_SIZE) >> 3;
+
+    for(uInt32 p = 0; p < FLAGS.size(); ++p)
+      if(plane(bank, p)[idx] & bit)
+        flags[offset] |= FLAGS[p];
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CodeCoverage::bankUsed(uInt32 bank) const
+{
+  const uInt8* bits = plane(bank, 0);
+
+  return std::any_of(bits, bits + FLAGS.size() * PLANE_SIZE,
+                     [](uInt8 b) { return b != 0; });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CodeCoverage::save(ostream& out) const
+{
+  const std::array<uInt8, 4> size = {
+    uInt8(mySize), uInt8(mySize >> 8), uInt8(mySize >> 16), uInt8(mySize >> 24)
+  };
+
+  out.write(reinterpret_cast<const char*>(HEADER.data()), HEADER.size());
+  out.write(myMD5.data(), MD5_SIZE);
+  out.write(reinterpret_cast<const char*>(size.data()), size.size());
+
+  // Banks which were never accessed are stored as a single byte
+  for(uInt32 bank = 0; bank < myBankCount; ++bank)
+  {
+    const bool used = bankUsed(bank);
+
+    out.put(used ? 1 : 0);
+    if(used)
+      out.write(reinterpret_cast<const char*>(plane(bank, 0)),
+                FLAGS.size() * PLANE_SIZE);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CodeCoverage::load(istream& in)
+{
+  std::array<uInt8, 8> header;
+  string md5(MD5_SIZE, ' ');
+  std::array<uInt8, 4> size;
+
+  if(!in.read(reinterpret_cast<char*>(header.data()), header.size()) ||
+     header != HEADER ||
+     !in.read(&md5[0], MD5_SIZE) ||
+     !in.read(reinterpret_cast<char*>(size.data()), size.size()))
+    return false;
+
+  if(md5 != myMD5 ||
+     (size[0] | (size[1] << 8) | (size[2] << 16) | (uInt32(size[3]) << 24)) != mySize)
+    return false;
+
+  // Read everything first, so that a truncated stream leaves the map unchanged
+  vector<uInt8> bits(myBits.size(), 0);
+  for(uInt32 bank = 0; bank < myBankCount; ++bank)
+  {
+    const int used = in.get();
+    if(used == EOF)
+      return false;
+    if(used && !in.read(reinterpret_cast<char*>(&bits[(bank * FLAGS.size()) * PLANE_SIZE]),
+                        FLAGS.size() * PLANE_SIZE))
+      return false;
+  }
+
+  for(size_t i = 0; i < myBits.size(); ++i)
+    myBits[i] |= bits[i];
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 CodeCoverage::count(uInt8 flag) const
+{
+  uInt32 total = 0;
+
+  for(uInt32 p = 0; p < FLAGS.size(); ++p)
+    if(FLAGS[p] == flag)
+      for(uInt32 bank = 0; bank < myBankCount; ++bank)
+      {
+        const uInt8* bits = plane(bank, p);
+        for(uInt32 i = 0; i < PLANE_SIZE; ++i)
+          for(uInt8 b = bits[i]; b; b &= b - 1)
+            ++total;
+      }
+
+  return total;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 CodeCoverage::usedBanks() const
+{
+  uInt32 total = 0;
+
+  for(uInt32 bank = 0; bank < myBankCount; ++bank)
+    if(bankUsed(bank))
+      ++total;
+
+  return total;
+}
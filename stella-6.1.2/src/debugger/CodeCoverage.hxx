@@ -0,0 +1,112 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef CODE_COVERAGE_HXX
+#define CODE_COVERAGE_HXX
+
+#include "bspf.hxx"
+
+/**
+  A compact map of the ROM bytes the emulation has seen used as code or
+  data (the CODE/GFX/PGFX/DATA access flags of the cartridge), which can
+  be merged with the maps of any number of other sessions.
+
+  The map covers the code-access array of the cartridge in banks of
+  BANK_SIZE bytes, each stored as one bitplane per flag.  In the stream,
+  a header is followed by the ROM's MD5 and size, then for each bank a
+  byte telling if it was accessed at all and, if so, its bitplanes.
+*/
+class CodeCoverage
+{
+  public:
+    static constexpr uInt32 BANK_SIZE = 4_KB;
+
+    /**
+      Create an empty map for the given ROM.
+
+      @param md5   The MD5 of the ROM, to make sure only maps of the
+                   same ROM are merged
+      @param size  The size of the code-access array of the cartridge
+    */
+    CodeCoverage(const string& md5, size_t size);
+
+    /**
+      Add the flags of the given code-access array (of the size
+      specified in the c'tor).
+    */
+    void snapshot(const uInt8* flags);
+
+    /**
+      Add the flags from the map to the given code-access array.
+    */
+    void apply(uInt8* flags) const;
+
+    /**
+      Read a map from the stream and merge it into this one.
+
+      @return  False if the stream is invalid or belongs to a different ROM
+    */
+    bool load(istream& in);
+
+    /**
+      Write the map to the stream.
+    */
+    void save(ostream& out) const;
+
+    /**
+      The number of bytes marked with the given flag.
+    */
+    uInt32 count(uInt8 flag) const;
+
+    /**
+      The number of banks of which any byte is marked.
+    */
+    uInt32 usedBanks() const;
+
+    uInt32 bankCount() const { return myBankCount; }
+
+  private:
+    static constexpr uInt32 PLANE_SIZE = BANK_SIZE / 8;
+
+    // The flags stored in the map, one bitplane each
+    static const std::array<uInt8, 4> FLAGS;
+
+    uInt8* plane(uInt32 bank, uInt32 p) {
+      return &myBits[(bank * FLAGS.size() + p) * PLANE_SIZE];
+    }
+    const uInt8* plane(uInt32 bank, uInt32 p) const {
+      return &myBits[(bank * FLAGS.size() + p) * PLANE_SIZE];
+    }
+    bool bankUsed(uInt32 bank) const;
+
+  private:
+    string myMD5;
+    uInt32 mySize{0};
+    uInt32 myBankCount{0};
+
+    vector<uInt8> myBits;
+
+  private:
+    // Following constructors and assignment operators not supported
+    CodeCoverage() = delete;
+    CodeCoverage(const CodeCoverage&) = delete;
+    CodeCoverage(CodeCoverage&&) = delete;
+    CodeCoverage& operator=(const CodeCoverage&) = delete;
+    CodeCoverage& operator=(CodeCoverage&&) = delete;
+};
+
+#endif
@@ -0,0 +1,113 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "Base.hxx"
+#include "CartDebug.hxx"
+#include "CycleProfiler.hxx"
+
+using Common::Base;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+CycleProfiler::CycleProfiler(uInt16 bankCount)
+  : myBankCount(bankCount),
+    myCounts((bankCount + 1) << 12, 0),
+    myCycles((bankCount + 1) << 12, 0),
+    myOrigin(bankCount + 1, 0x1000)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+vector<uInt32> CycleProfiler::sortedIndices() const
+{
+  vector<uInt32> indices;
+  for(uInt32 idx = 0; idx < myCounts.size(); ++idx)
+    if(myCounts[idx])
+      indices.push_back(idx);
+
+  std::stable_sort(indices.begin(), indices.end(),
+    [this](uInt32 a, uInt32 b) { return myCycles[a] > myCycles[b]; });
+
+  return indices;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CycleProfiler::saveText(ostream& out, const CartDebug& dbg) const
+{
+  out << "; Stella cycle profile\n"
+      << "; " << myTotalCycles << " CPU cycles\n\n"
+      << "; bank  addr  label                 executions          cycles       %\n";
+
+  for(uInt32 idx: sortedIndices())
+  {
+    const uInt16 bank = idx >> 12;
+    const uInt16 addr = address(idx);
+
+    if(bank < myBankCount)
+      out << std::setw(6) << std::right << std::dec << bank;
+    else
+      out << "   RAM";
+    out << "  " << Base::HEX4 << addr << "  " << std::setfill(' ')
+        << std::setw(20) << std::left << dbg.getLabel(addr, true)
+        << std::setw(12) << std::right << std::dec << myCounts[idx]
+        << std::setw(16) << myCycles[idx]
+        << std::setw(8) << std::fixed << std::setprecision(2)
+        << (myTotalCycles ? 100.0 * myCycles[idx] / myTotalCycles : 0.0) << "\n";
+  }
+
+  out << "\n; CPU cycles used per scanline before WSYNC (76 available)\n"
+      << "; line  wsyncs     avg  min  max\n";
+  for(uInt32 i = 0; i < MAX_SCANLINES; ++i)
+  {
+    const Scanline& line = myScanlines[i];
+    if(line.count)
+      out << std::setw(6) << std::dec << i
+          << std::setw(8) << line.count
+          << std::setw(8) << std::fixed << std::setprecision(1)
+          << double(line.cycles) / line.count
+          << std::setw(5) << line.minCycles
+          << std::setw(5) << line.maxCycles << "\n";
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CycleProfiler::saveCSV(ostream& out, const CartDebug& dbg) const
+{
+  out << "bank,address,label,executions,cycles\n";
+  for(uInt32 idx: sortedIndices())
+  {
+    const uInt16 bank = idx >> 12;
+    const uInt16 addr = address(idx);
+
+    if(bank < myBankCount)
+      out << std::dec << bank;
+    else
+      out << "RAM";
+    out << "," << Base::HEX4 << addr << std::setfill(' ')
+        << "," << dbg.getLabel(addr, true)
+        << "," << std::dec << myCounts[idx] << "," << myCycles[idx] << "\n";
+  }
+
+  out << "\nscanline,wsyncs,avg_cycles,min_cycles,max_cycles\n";
+  for(uInt32 i = 0; i < MAX_SCANLINES; ++i)
+  {
+    const Scanline& line = myScanlines[i];
+    if(line.count)
+      out << std::dec << i << "," << line.count << ","
+          << std::fixed << std::setprecision(1) << double(line.cycles) / line.count
+          << "," << line.minCycles << "," << line.maxCycles << "\n";
+  }
+}
@@ -0,0 +1,129 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef CYCLE_PROFILER_HXX
+#define CYCLE_PROFILER_HXX
+
+class CartDebug;
+
+#include "bspf.hxx"
+
+/**
+  Collects the number of executions and CPU cycles spent for each address
+  of each bank, as well as the CPU cycles used on each scanline before the
+  kernel waits for WSYNC.
+
+  All counters are kept in flat arrays, indexed by bank and the lower
+  12 address bits; code executed from outside the cartridge space (ie,
+  from zero-page RAM) is collected in an additional pseudo bank.
+*/
+class CycleProfiler
+{
+  public:
+    static constexpr uInt32 MAX_SCANLINES = 512;
+
+    explicit CycleProfiler(uInt16 bankCount);
+
+    /**
+      Account one executed instruction.
+
+      @param pc      The address the instruction was fetched from
+      @param bank    The bank the address was mapped to
+      @param cycles  The CPU cycles used, including a WSYNC halt
+    */
+    void addInstruction(uInt16 pc, uInt16 bank, uInt32 cycles) {
+      const uInt32 idx = index(pc, bank);
+      myOrigin[idx >> 12] = pc & 0xF000;
+      ++myCounts[idx];
+      myCycles[idx] += cycles;
+      myTotalCycles += cycles;
+    }
+
+    /**
+      Account the CPU cycles used on a scanline up to a WSYNC.
+    */
+    void addScanline(uInt32 scanline, uInt32 cycles) {
+      Scanline& line = myScanlines[std::min(scanline, MAX_SCANLINES - 1)];
+      line.cycles += cycles;
+      line.minCycles = std::min(line.minCycles, cycles);
+      line.maxCycles = std::max(line.maxCycles, cycles);
+      ++line.count;
+    }
+
+    uInt64 cycles(uInt16 address, uInt16 bank) const {
+      return myCycles[index(address, bank)];
+    }
+    uInt32 count(uInt16 address, uInt16 bank) const {
+      return myCounts[index(address, bank)];
+    }
+    uInt64 totalCycles() const { return myTotalCycles; }
+
+    /**
+      Write the results as a human-readable report, sorted by cycles.
+
+      @param out  The stream to write to
+      @param dbg  Used to look up the labels of the addresses
+    */
+    void saveText(ostream& out, const CartDebug& dbg) const;
+
+    /**
+      Write the results as comma-separated values; the address table is
+      followed by the scanline table.
+    */
+    void saveCSV(ostream& out, const CartDebug& dbg) const;
+
+  private:
+    struct Scanline {
+      uInt64 cycles{0};
+      uInt32 count{0};
+      uInt32 minCycles{~0U}, maxCycles{0};
+    };
+
+    uInt32 index(uInt16 address, uInt16 bank) const {
+      if(!(address & 0x1000) || bank >= myBankCount)
+        bank = myBankCount;
+      return (uInt32(bank) << 12) | (address & 0x0FFF);
+    }
+
+    // Returns the indices of all executed addresses, sorted by cycles
+    vector<uInt32> sortedIndices() const;
+
+    // The full address of an entry
+    uInt16 address(uInt32 idx) const {
+      return myOrigin[idx >> 12] | (idx & 0x0FFF);
+    }
+
+  private:
+    uInt16 myBankCount{0};
+
+    vector<uInt32> myCounts;
+    vector<uInt64> myCycles;
+    vector<uInt16> myOrigin;    // upper address bits last used by each bank
+    uInt64 myTotalCycles{0};
+
+    std::array<Scanline, MAX_SCANLINES> myScanlines;
+
+  private:
+    // Following constructors and assignment operators not supported
+    CycleProfiler() = delete;
+    CycleProfiler(const CycleProfiler&) = delete;
+    CycleProfiler(CycleProfiler&&) = delete;
+    CycleProfiler& operator=(const CycleProfiler&) = delete;
+    CycleProfiler& operator=(CycleProfiler&&) = delete;
+};
+
+#endif
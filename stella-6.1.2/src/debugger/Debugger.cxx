@@ -39,6 +39,9 @@
 #include "CartDebugWidget.hxx"
 #include "CartRamWidget.hxx"
 #include "CpuDebug.hxx"
+#include "CycleProfiler.hxx"
+#include "DiStella.hxx"
+#include "InstructionTrace.hxx"
 #include "RiotDebug.hxx"
 #include "TIADebug.hxx"
 
@@ -84,6 +87,8 @@ Debugger::Debugger(OSystem& osystem, Console& console)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Debugger::~Debugger()
 {
+  if(myTrace)
+    myTrace->flush();
   delete myDialog;  myDialog = nullptr;
 }
 
@@ -174,7 +179,13 @@ string Debugger::autoExec(StringList* history)
   FilesystemNode romname(myOSystem.romFile().getPathWithExt(".script"));
   buf << myParser->exec(romname, history) << endl;
 
-  // Init builtins
+  addBuiltinFunctions();
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Debugger::addBuiltinFunctions()
+{
   for(const auto& func: ourBuiltinFunctions)
   {
     // TODO - check this for memory leaks
@@ -184,7 +195,6 @@ string Debugger::autoExec(StringList* history)
     else
       cerr << "ERROR in builtin function!" << endl;
   }
-  return buf.str();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -346,6 +356,163 @@ int Debugger::trace()
     return step();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Debugger::setProfiling(bool enable)
+{
+  if(enable)
+    myProfiler = make_unique<CycleProfiler>(myConsole.cartridge().bankCount());
+
+  myProfiling = enable;
+  mySystem.m6502().setProfiler(enable ? myProfiler.get() : nullptr);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string Debugger::saveProfile(bool csv)
+{
+  if(!myProfiler)
+    return DebuggerParser::red("no profile collected (use 'profile' first)");
+
+  const string& name = myConsole.properties().get(PropType::Cart_Name) +
+                       (csv ? ".profile.csv" : ".profile.txt");
+  FilesystemNode node(myOSystem.defaultSaveDir() + name);
+  ofstream out(node.getPath());
+  if(!out.is_open())
+    return DebuggerParser::red("unable to save profile to " + node.getShortPath());
+
+  if(csv)
+    myProfiler->saveCSV(out, *myCartDebug);
+  else
+    myProfiler->saveText(out, *myCartDebug);
+
+  return "saved profile as " + node.getShortPath();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string Debugger::setTracing(bool enable)
+{
+  ostringstream buf;
+
+  if(enable && !myTrace)
+  {
+    FilesystemNode node(myOSystem.defaultSaveDir() +
+                        myConsole.properties().get(PropType::Cart_Name) + ".trace");
+    myTraceFile.open(node.getPath(), std::ios::binary);
+    if(!myTraceFile.is_open())
+      return DebuggerParser::red("unable to save trace to " + node.getShortPath());
+
+    myTraceFileName = node.getShortPath();
+    myTrace = make_unique<InstructionTrace>();
+    myTrace->setStream(&myTraceFile);
+    mySystem.m6502().setTrace(myTrace.get());
+
+    buf << "instruction trace started, streaming to " << myTraceFileName;
+  }
+  else if(!enable && myTrace)
+  {
+    mySystem.m6502().setTrace(nullptr);
+    myTrace->flush();
+    myTraceFile.close();
+
+    buf << "instruction trace stopped, " << myTrace->count()
+        << " instructions saved to " << myTraceFileName;
+    myTrace.reset();
+  }
+  else
+    buf << "instruction trace already " << (enable ? "started" : "stopped");
+
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string Debugger::decodeTrace(const string& file)
+{
+  FilesystemNode node(file != "" ? file : myOSystem.defaultSaveDir() +
+                      myConsole.properties().get(PropType::Cart_Name) + ".trace");
+  if(!node.exists())
+    node = FilesystemNode(myOSystem.defaultSaveDir() + file);
+
+  ifstream in(node.getPath(), std::ios::binary);
+  if(!in.is_open() || !InstructionTrace::readHeader(in))
+    return DebuggerParser::red("unable to read trace from " + node.getShortPath());
+
+  FilesystemNode outNode(node.getPath() + ".txt");
+  ofstream out(outNode.getPath());
+  if(!out.is_open())
+    return DebuggerParser::red("unable to save " + outNode.getShortPath());
+
+  out << ";      cycle  +cy line clk bank addr  bytes     instruction       "
+         "A  X  Y  SP flags    read write\n";
+
+  InstructionTrace::Entry entry;
+  uInt32 lastCycle = 0;
+  uInt64 count = 0;
+  while(InstructionTrace::read(in, entry))
+  {
+    const uInt8 size = DiStella::instructionSize(entry.opcode);
+    ostringstream bytes;
+    bytes << Base::HEX2 << int(entry.opcode);
+    for(uInt8 i = 1; i < size; ++i)
+      bytes << " " << Base::HEX2 << int(entry.operand[i - 1]);
+
+    string flags = "nv-bdizc";
+    for(int i = 0; i < 8; ++i)
+      if(entry.ps & (0x80 >> i))
+        flags[i] = toupper(flags[i]);
+
+    out << std::dec << std::setfill(' ') << std::right
+        << std::setw(12) << entry.cycle << " ";
+    if(count++)
+      out << std::setw(4) << uInt32(entry.cycle - lastCycle);
+    else
+      out << "    ";
+    out << std::setw(5) << entry.scanline << std::setw(4) << int(entry.clock)
+        << std::setw(5) << entry.bank << " " << Base::HEX4 << entry.pc
+        << "  " << std::setfill(' ') << std::setw(10) << std::left << bytes.str()
+        << std::setw(18) << DiStella::disassemble(entry.pc, entry.opcode, entry.operand)
+        << Base::HEX2 << int(entry.a) << " " << Base::HEX2 << int(entry.x) << " "
+        << Base::HEX2 << int(entry.y) << " " << Base::HEX2 << int(entry.sp) << " "
+        << flags << " " << Base::HEX4 << entry.peekAddress << " "
+        << Base::HEX4 << entry.pokeAddress << "\n";
+    lastCycle = entry.cycle;
+  }
+
+  ostringstream buf;
+  buf << "decoded " << std::dec << count << " instructions to " << outNode.getShortPath();
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int Debugger::runTo(const BreakpointMap* pcs, Expression* whileCond,
+                    const string& rewindMsg, bool& reached, string& breakMsg)
+{
+  saveOldState();
+
+  uInt64 startCycle = mySystem.cycles();
+  M6502& cpu = mySystem.m6502();
+  DispatchResult result;
+
+  cpu.setRunTo(pcs, whileCond);
+  unlockSystem();
+  // The TIA stops the CPU at the end of each frame, so keep going until
+  // the target is reached, a break occurs or ~10 seconds have passed
+  uInt64 elapsed = 0;
+  do
+  {
+    cpu.execute(11900000 - elapsed, result);
+    elapsed = mySystem.cycles() - startCycle;
+  }
+  while(!cpu.runToHit() && result.getStatus() == DispatchResult::Status::ok &&
+        elapsed < 11900000);
+  myOSystem.console().tia().flushLineCache();
+  lockSystem();
+  reached = cpu.clearRunTo();
+  breakMsg = result.getStatus() == DispatchResult::Status::debugger
+             ? result.getMessage() : EmptyString;
+
+  addState(rewindMsg);
+  return int(mySystem.cycles() - startCycle);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Debugger::setBreakPoint(uInt16 addr, uInt8 bank, uInt32 flags)
 {
@@ -388,40 +555,36 @@ bool Debugger::toggleBreakPoint(uInt16 addr, uInt8 bank)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Debugger::addReadTrap(uInt16 t)
+void Debugger::addReadTrap(const TrapArray::Range& t)
 {
-  readTraps().initialize();
   readTraps().add(t);
 }
 
-void Debugger::addWriteTrap(uInt16 t)
+void Debugger::addWriteTrap(const TrapArray::Range& t)
 {
-  writeTraps().initialize();
   writeTraps().add(t);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Debugger::addTrap(uInt16 t)
+void Debugger::addTrap(const TrapArray::Range& t)
 {
   addReadTrap(t);
   addWriteTrap(t);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Debugger::removeReadTrap(uInt16 t)
+void Debugger::removeReadTrap(const TrapArray::Range& t)
 {
-  readTraps().initialize();
   readTraps().remove(t);
 }
 
-void Debugger::removeWriteTrap(uInt16 t)
+void Debugger::removeWriteTrap(const TrapArray::Range& t)
 {
-  writeTraps().initialize();
   writeTraps().remove(t);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Debugger::removeTrap(uInt16 t)
+void Debugger::removeTrap(const TrapArray::Range& t)
 {
   removeReadTrap(t);
   removeWriteTrap(t);
@@ -430,13 +593,13 @@ void Debugger::removeTrap(uInt16 t)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Debugger::readTrap(uInt16 t)
 {
-  return readTraps().isInitialized() && readTraps().isSet(t);
+  return readTraps().isSet(t);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Debugger::writeTrap(uInt16 t)
 {
-  return writeTraps().isInitialized() && writeTraps().isSet(t);
+  return writeTraps().isSet(t);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -577,8 +740,20 @@ void Debugger::nextFrame(int frames)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Debugger::updateRewindbuttons(const RewindManager& r)
 {
-  myDialog->rewindButton().setEnabled(!r.atFirst());
-  myDialog->unwindButton().setEnabled(!r.atLast());
+  if(myDialog)
+  {
+    myDialog->rewindButton().setEnabled(!r.atFirst());
+    myDialog->unwindButton().setEnabled(!r.atLast());
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Debugger::invalidateRom(bool forcereload) const
+{
+  if(myDialog)
+    myDialog->rom().invalidate(forcereload);
+  else
+    myCartDebug->disassemble(forcereload);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -682,7 +857,7 @@ void Debugger::setStartState()
     updateRewindbuttons(r);
 
   // Set the 're-disassemble' flag, but don't do it until the next scheduled time
-  myDialog->rom().invalidate(false);
+  invalidateRom(false);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -28,7 +28,8 @@ class EditTextWidget;
 class RomWidget;
 class Expression;
 class BreakpointMap;
-class TrapArray;
+class CycleProfiler;
+class InstructionTrace;
 class PromptWidget;
 class ButtonWidget;
 
@@ -47,6 +48,7 @@ class RewindManager;
 #include "DialogContainer.hxx"
 #include "DebuggerDialog.hxx"
 #include "FrameBufferConstants.hxx"
+#include "TrapArray.hxx"
 #include "bspf.hxx"
 
 /**
@@ -63,6 +65,7 @@ class Debugger : public DialogContainer
   friend class DebuggerParser;
   friend class EventHandler;
   friend class M6502;
+  friend class ScriptRunner;
 
   public:
     using FunctionMap = std::map<string, unique_ptr<Expression>>;
@@ -152,6 +155,12 @@ class Debugger : public DialogContainer
     RomWidget& rom() const              { return myDialog->rom();       }
     TiaOutputWidget& tiaOutput() const  { return myDialog->tiaOutput(); }
 
+    /**
+      Invalidate the disassembly of the ROM widget.  The dialog doesn't
+      exist when running scripts, so the disassembly is updated directly.
+    */
+    void invalidateRom(bool forcereload = true) const;
+
     BreakpointMap& breakPoints() const;
 
     TrapArray& readTraps() const;
@@ -186,6 +195,36 @@ class Debugger : public DialogContainer
     */
     bool checkBreakPoint(uInt16 addr, uInt8 bank);
 
+    /**
+      Starts or stops the cycle profiler.  Starting it discards all
+      previously collected results.
+    */
+    void setProfiling(bool enable);
+    bool isProfiling() const { return myProfiling; }
+
+    /**
+      The results of the last profiler run, or nullptr if there are none.
+    */
+    const CycleProfiler* profiler() const { return myProfiler.get(); }
+
+    /**
+      Saves the profiler results (with default name) as text or CSV.
+    */
+    string saveProfile(bool csv);
+
+    /**
+      Starts or stops recording every executed instruction.  The trace is
+      streamed to a binary file (with default name) while it runs.
+    */
+    string setTracing(bool enable);
+    bool isTracing() const { return myTrace != nullptr; }
+
+    /**
+      Decodes a binary instruction trace into a text file, named like the
+      trace file with '.txt' appended.
+    */
+    string decodeTrace(const string& file);
+
     /**
       Run the debugger command and return the result.
     */
@@ -305,8 +344,27 @@ class Debugger : public DialogContainer
     */
     void setQuitState();
 
+    /**
+      Define the builtin functions (_joy0left etc.) for use in expressions.
+    */
+    void addBuiltinFunctions();
+
     int step();
     int trace();
+
+    /**
+      Run at full emulation speed (for at most ~10 seconds) until PC reaches
+      one of the addresses (and banks) in 'pcs', or 'whileCond' evaluates
+      false.  Either may be null.  Only one rewind state is recorded.
+
+      @param reached    Set to whether the stop condition was met
+      @param breakMsg   Set to the message of a breakpoint, trap or
+                        conditional break which stopped the run early,
+                        otherwise empty
+      @return  The number of cycles executed
+    */
+    int runTo(const BreakpointMap* pcs, Expression* whileCond,
+              const string& rewindMsg, bool& reached, string& breakMsg);
     void nextScanline(int lines);
     void nextFrame(int frames);
     uInt16 rewindStates(const uInt16 numStates, string& message);
@@ -314,12 +372,12 @@ class Debugger : public DialogContainer
 
     void clearAllBreakPoints();
 
-    void addReadTrap(uInt16 t);
-    void addWriteTrap(uInt16 t);
-    void addTrap(uInt16 t);
-    void removeReadTrap(uInt16 t);
-    void removeWriteTrap(uInt16 t);
-    void removeTrap(uInt16 t);
+    void addReadTrap(const TrapArray::Range& t);
+    void addWriteTrap(const TrapArray::Range& t);
+    void addTrap(const TrapArray::Range& t);
+    void removeReadTrap(const TrapArray::Range& t);
+    void removeWriteTrap(const TrapArray::Range& t);
+    void removeTrap(const TrapArray::Range& t);
     bool readTrap(uInt16 t);
     bool writeTrap(uInt16 t);
     void clearAllTraps();
@@ -345,6 +403,13 @@ class Debugger : public DialogContainer
     unique_ptr<RiotDebug>      myRiotDebug;
     unique_ptr<TIADebug>       myTiaDebug;
 
+    unique_ptr<CycleProfiler> myProfiler;
+    bool myProfiling{false};
+
+    unique_ptr<InstructionTrace> myTrace;
+    ofstream myTraceFile;
+    string myTraceFileName;
+
     static Debugger* myStaticDebugger;
 
     FunctionMap myFunctions;
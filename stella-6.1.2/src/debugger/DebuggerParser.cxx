@@ -33,7 +33,6 @@
 #include "Settings.hxx"
 #include "PromptWidget.hxx"
 #include "RomWidget.hxx"
-#include "ProgressDialog.hxx"
 #include "TimerManager.hxx"
 #include "Vec.hxx"
 
@@ -114,7 +113,7 @@ string DebuggerParser::run(const string& command)
         commands[i].executor(this);
       }
 
-      if(commands[i].refreshRequired)
+      if(commands[i].refreshRequired && debugger.baseDialog())
         debugger.baseDialog()->loadConfig();
 
       return commandResult.str();
@@ -927,7 +926,7 @@ void DebuggerParser::executeCode()
                   CartDebug::CODE, args[0], args[1]);
   commandResult << (result ? "added" : "removed") << " CODE directive on range $"
                 << hex << args[0] << " $" << hex << args[1];
-  debugger.rom().invalidate();
+  debugger.invalidateRom();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -968,7 +967,7 @@ void DebuggerParser::executeData()
                   CartDebug::DATA, args[0], args[1]);
   commandResult << (result ? "added" : "removed") << " DATA directive on range $"
                 << hex << args[0] << " $" << hex << args[1];
-  debugger.rom().invalidate();
+  debugger.invalidateRom();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -978,13 +977,20 @@ void DebuggerParser::executeDebugColors()
   commandResult << debugger.tiaDebug().debugColors();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "decodetrace"
+void DebuggerParser::executeDecodetrace()
+{
+  commandResult << debugger.decodeTrace(argCount == 1 ? argStrings[0] : "");
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "define"
 void DebuggerParser::executeDefine()
 {
   // TODO: check if label already defined?
   debugger.cartDebug().addLabel(argStrings[0], args[1]);
-  debugger.rom().invalidate();
+  debugger.invalidateRom();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1025,8 +1031,8 @@ void DebuggerParser::executeDeltrap()
 
   if(debugger.m6502().delCondTrap(index))
   {
-    for(uInt32 addr = myTraps[index]->begin; addr <= myTraps[index]->end; ++addr)
-      executeTrapRW(addr, myTraps[index]->read, myTraps[index]->write, false);
+    executeTrapRW(myTraps[index]->begin, myTraps[index]->end,
+                  myTraps[index]->read, myTraps[index]->write, false);
     // @sa666666: please check this:
     Vec::removeAt(myTraps, index);
     commandResult << "removed trap " << Base::toString(index);
@@ -1285,7 +1291,7 @@ void DebuggerParser::executeGfx()
                   CartDebug::GFX, args[0], args[1]);
   commandResult << (result ? "added" : "removed") << " GFX directive on range $"
                 << hex << args[0] << " $" << hex << args[1];
-  debugger.rom().invalidate();
+  debugger.invalidateRom();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1322,6 +1328,13 @@ void DebuggerParser::executeHelp()
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "itrace"
+void DebuggerParser::executeItrace()
+{
+  commandResult << debugger.setTracing(argCount == 0 ? !debugger.isTracing() : args[0] != 0);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "joy0up"
 void DebuggerParser::executeJoy0Up()
@@ -1592,6 +1605,13 @@ void DebuggerParser::executeLoadconfig()
   commandResult << debugger.cartDebug().loadConfigFile();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "loadcoverage"
+void DebuggerParser::executeLoadcoverage()
+{
+  commandResult << debugger.cartDebug().loadCoverage(argStrings);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "loadstate"
 void DebuggerParser::executeLoadstate()
@@ -1645,7 +1665,7 @@ void DebuggerParser::executePGfx()
                   CartDebug::PGFX, args[0], args[1]);
   commandResult << (result ? "added" : "removed") << " PGFX directive on range $"
                 << hex << args[0] << " $" << hex << args[1];
-  debugger.rom().invalidate();
+  debugger.invalidateRom();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1655,6 +1675,16 @@ void DebuggerParser::executePrint()
   commandResult << eval();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "profile"
+void DebuggerParser::executeProfile()
+{
+  bool enable = argCount == 0 ? !debugger.isProfiling() : args[0] != 0;
+
+  debugger.setProfiling(enable);
+  commandResult << "cycle profiler " << (enable ? "started" : "stopped");
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "ram"
 void DebuggerParser::executeRam()
@@ -1670,7 +1700,7 @@ void DebuggerParser::executeRam()
 void DebuggerParser::executeReset()
 {
   debugger.reset();
-  debugger.rom().invalidate();
+  debugger.invalidateRom();
 
   ControllerLowLevel lport(debugger.myOSystem.console().leftController());
   ControllerLowLevel rport(debugger.myOSystem.console().rightController());
@@ -1713,7 +1743,7 @@ void DebuggerParser::executeRom()
   // The RomWidget is a special case, since we don't want to re-disassemble
   // any more than necessary.  So we only do it by calling the following
   // method ...
-  debugger.rom().invalidate();
+  debugger.invalidateRom();
 
   commandResult << "changed " << (args.size() - 1) << " location(s)";
 }
@@ -1737,7 +1767,7 @@ void DebuggerParser::executeRow()
                   CartDebug::ROW, args[0], args[1]);
   commandResult << (result ? "added" : "removed") << " ROW directive on range $"
                 << hex << args[0] << " $" << hex << args[1];
-  debugger.rom().invalidate();
+  debugger.invalidateRom();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1753,70 +1783,64 @@ void DebuggerParser::executeRun()
 // "runto"
 void DebuggerParser::executeRunTo()
 {
-  const CartDebug& cartdbg = debugger.cartDebug();
+  CartDebug& cartdbg = debugger.cartDebug();
   const CartDebug::DisassemblyList& list = cartdbg.disassembly().list;
 
-  uInt32 count = 0, max_iterations = uInt32(list.size());
+  // Search the disassembly once, and let the CPU stop on any matching line
+  // (only in the bank it was found in)
+  M6502::RunToPCs pcs;
+  for(const auto& line: list)
+    if(BSPF::findIgnoreCase(line.disasm, argStrings[0]) != string::npos)
+      pcs.add(line.address, cartdbg.getBank(line.address));
 
-  // Create a progress dialog box to show the progress searching through the
-  // disassembly, since this may be a time-consuming operation
-  ostringstream buf;
-  buf << "RunTo searching through " << max_iterations << " disassembled instructions";
-  ProgressDialog progress(debugger.baseDialog(), debugger.lfont(), buf.str());
-  progress.setRange(0, max_iterations, 5);
+  if(pcs.size() == 0)
+  {
+    commandResult << argStrings[0] << " not found in disassembly";
+    return;
+  }
 
   bool done = false;
-  do {
-    debugger.step();
-
-    // Update romlist to point to current PC
-    int pcline = cartdbg.addressToLine(debugger.cpuDebug().pc());
-    if(pcline >= 0)
-    {
-      const string& next = list[pcline].disasm;
-      done = (BSPF::findIgnoreCase(next, argStrings[0]) != string::npos);
-    }
-    // Update the progress bar
-    progress.setProgress(count);
-  } while(!done && ++count < max_iterations);
-
-  progress.close();
+  string breakMsg;
+  int cycles = debugger.runTo(&pcs, nullptr, "runto", done, breakMsg);
 
   if(done)
     commandResult
-      << "found " << argStrings[0] << " in " << dec << count
-      << " disassembled instructions";
+      << "found " << argStrings[0] << " after " << dec << cycles << " cycles";
+  else if(breakMsg != EmptyString)
+    commandResult
+      << "stopped at " << breakMsg << " after " << dec << cycles << " cycles";
   else
     commandResult
-      << argStrings[0] << " not found in " << dec << count
-      << " disassembled instructions";
+      << argStrings[0] << " not reached after " << dec << cycles << " cycles";
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "runtopc"
 void DebuggerParser::executeRunToPc()
 {
-  const CartDebug& cartdbg = debugger.cartDebug();
-  const CartDebug::DisassemblyList& list = cartdbg.disassembly().list;
+  CartDebug& cartdbg = debugger.cartDebug();
 
-  uInt32 count = 0;
   bool done = false;
-  do {
-    debugger.step();
-
-    // Update romlist to point to current PC
-    int pcline = cartdbg.addressToLine(debugger.cpuDebug().pc());
-    done = (pcline >= 0) && (list[pcline].address == args[0]);
-  } while(!done && ++count < list.size());
+  string breakMsg;
+  int cycles = 0;
+  if(cartdbg.addressToLine(args[0]) >= 0)
+  {
+    M6502::RunToPCs pcs;
+    pcs.add(args[0], cartdbg.getBank(args[0]));
+    cycles = debugger.runTo(&pcs, nullptr, "runtopc", done, breakMsg);
+  }
 
   if(done)
     commandResult
-      << "set PC to " << Base::HEX4 << args[0] << " in "
-      << dec << count << " disassembled instructions";
+      << "set PC to " << Base::HEX4 << args[0] << " after "
+      << dec << cycles << " cycles";
+  else if(breakMsg != EmptyString)
+    commandResult
+      << "stopped at " << breakMsg << " after " << dec << cycles << " cycles";
   else
     commandResult
-      << "PC " << Base::HEX4 << args[0] << " not reached or found in "
-      << dec << count << " disassembled instructions";
+      << "PC " << Base::HEX4 << args[0] << " not reached or found after "
+      << dec << cycles << " cycles";
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1840,6 +1864,13 @@ void DebuggerParser::executeSaveconfig()
   commandResult << debugger.cartDebug().saveConfigFile();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "savecoverage"
+void DebuggerParser::executeSavecoverage()
+{
+  commandResult << debugger.cartDebug().saveCoverage(argCount == 1 ? argStrings[0] : "");
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "savedis"
 void DebuggerParser::executeSavedisassembly()
@@ -1847,6 +1878,21 @@ void DebuggerParser::executeSavedisassembly()
   commandResult << debugger.cartDebug().saveDisassembly();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "saveprofile"
+void DebuggerParser::executeSaveprofile()
+{
+  if(argCount == 1 && !BSPF::equalsIgnoreCase(argStrings[0], "csv") &&
+     !BSPF::equalsIgnoreCase(argStrings[0], "txt"))
+  {
+    commandResult << red("invalid format (use 'txt' or 'csv')");
+    return;
+  }
+
+  commandResult << debugger.saveProfile(argCount == 1 &&
+                   BSPF::equalsIgnoreCase(argStrings[0], "csv"));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "saverom"
 void DebuggerParser::executeSaverom()
@@ -1945,12 +1991,16 @@ void DebuggerParser::executeStepwhile()
     commandResult << red("invalid expression");
     return;
   }
-  Expression* expr = YaccParser::getResult();
-  int ncycles = 0;
-  do {
-    ncycles += debugger.step();
-  } while (expr->evaluate());
+  unique_ptr<Expression> expr(YaccParser::getResult());
+
+  bool done = false;
+  string breakMsg;
+  int ncycles = debugger.runTo(nullptr, expr.get(), "stepwhile", done, breakMsg);
   commandResult << "executed " << ncycles << " cycles";
+  if(breakMsg != EmptyString)
+    commandResult << " (stopped at " << breakMsg << ")";
+  else if(!done)
+    commandResult << red(" (condition still true, stopped)");
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -2105,8 +2155,7 @@ void DebuggerParser::executeTraps(bool read, bool write, const string& command,
       myTraps.emplace_back(make_unique<Trap>(read, write, begin, end, condition));
     }
 
-    for(uInt32 addr = begin; addr <= end; ++addr)
-      executeTrapRW(addr, read, write, add);
+    executeTrapRW(begin, end, read, write, add);
   }
   else
   {
@@ -2116,71 +2165,56 @@ void DebuggerParser::executeTraps(bool read, bool write, const string& command,
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // wrapper function for trap(if)/trapread(if)/trapwrite(if) commands
-void DebuggerParser::executeTrapRW(uInt32 addr, bool read, bool write, bool add)
+void DebuggerParser::executeTrapRW(uInt32 begin, uInt32 end, bool read, bool write, bool add)
 {
-  switch(debugger.cartDebug().addressType(addr))
+  TrapArray::RangeList readRanges, writeRanges;
+
+  // Each run of addresses of the same type is trapped including all its mirrors
+  for(uInt32 addr = begin; addr <= end; ++addr)
   {
-    case CartDebug::AddrType::TIA:
-    {
-      for(uInt32 i = 0; i <= 0xFFFF; ++i)
-      {
-        if((i & 0x1080) == 0x0000)
-        {
-          // @sa666666: This seems wrong. E.g. trapread 40 4f will never trigger
-          if(read && (i & 0x000F) == (addr & 0x000F))
-            add ? debugger.addReadTrap(i) : debugger.removeReadTrap(i);
-          if(write && (i & 0x003F) == (addr & 0x003F))
-            add ? debugger.addWriteTrap(i) : debugger.removeWriteTrap(i);
-        }
-      }
-      break;
-    }
-    case CartDebug::AddrType::IO:
-    {
-      for(uInt32 i = 0; i <= 0xFFFF; ++i)
-      {
-        if((i & 0x1280) == 0x0280 && (i & 0x029F) == (addr & 0x029F))
-        {
-          if(read)
-            add ? debugger.addReadTrap(i) : debugger.removeReadTrap(i);
-          if(write)
-            add ? debugger.addWriteTrap(i) : debugger.removeWriteTrap(i);
-        }
-      }
-      break;
-    }
-    case CartDebug::AddrType::ZPRAM:
-    {
-      for(uInt32 i = 0; i <= 0xFFFF; ++i)
-      {
-        if((i & 0x1280) == 0x0080 && (i & 0x00FF) == (addr & 0x00FF))
-        {
-          if(read)
-            add ? debugger.addReadTrap(i) : debugger.removeReadTrap(i);
-          if(write)
-            add ? debugger.addWriteTrap(i) : debugger.removeWriteTrap(i);
-        }
-      }
-      break;
-    }
-    case CartDebug::AddrType::ROM:
+    const CartDebug::AddrType type = debugger.cartDebug().addressType(addr);
+    uInt32 last = addr;
+    while(last < end && debugger.cartDebug().addressType(last + 1) == type)
+      ++last;
+
+    switch(type)
     {
-      if(addr >= 0x1000 && addr <= 0xFFFF)
-      {
-        for(uInt32 i = 0x1000; i <= 0xFFFF; ++i)
-        {
-          if((i % 0x2000 >= 0x1000) && (i & 0x0FFF) == (addr & 0x0FFF))
-          {
-            if(read)
-              add ? debugger.addReadTrap(i) : debugger.removeReadTrap(i);
-            if(write)
-              add ? debugger.addWriteTrap(i) : debugger.removeWriteTrap(i);
-          }
-        }
-      }
-      break;
+      case CartDebug::AddrType::TIA:
+        // @sa666666: This seems wrong. E.g. trapread 40 4f will never trigger
+        if(read)
+          TrapArray::addMirrors(readRanges, addr, last, 0x1080, 0x0000, 0x000F);
+        if(write)
+          TrapArray::addMirrors(writeRanges, addr, last, 0x1080, 0x0000, 0x003F);
+        break;
+
+      case CartDebug::AddrType::IO:
+        if(read)
+          TrapArray::addMirrors(readRanges, addr, last, 0x1280, 0x0280, 0x001F);
+        if(write)
+          TrapArray::addMirrors(writeRanges, addr, last, 0x1280, 0x0280, 0x001F);
+        break;
+
+      case CartDebug::AddrType::ZPRAM:
+        if(read)
+          TrapArray::addMirrors(readRanges, addr, last, 0x1280, 0x0080, 0x007F);
+        if(write)
+          TrapArray::addMirrors(writeRanges, addr, last, 0x1280, 0x0080, 0x007F);
+        break;
+
+      case CartDebug::AddrType::ROM:
+        if(read)
+          TrapArray::addMirrors(readRanges, addr, last, 0x1000, 0x1000, 0x0FFF);
+        if(write)
+          TrapArray::addMirrors(writeRanges, addr, last, 0x1000, 0x1000, 0x0FFF);
+        break;
     }
+    addr = last;
   }
+
+  for(const auto& range: readRanges)
+    add ? debugger.addReadTrap(range) : debugger.removeReadTrap(range);
+  for(const auto& range: writeRanges)
+    add ? debugger.addWriteTrap(range) : debugger.removeWriteTrap(range);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -2207,7 +2241,7 @@ void DebuggerParser::executeUHex()
   Base::setHexUppercase(enable);
 
   settings.setValue("dbg.uhex", enable);
-  debugger.rom().invalidate();
+  debugger.invalidateRom();
 
   commandResult << "uppercase HEX " << (enable ? "enabled" : "disabled");
 }
@@ -2218,7 +2252,7 @@ void DebuggerParser::executeUndef()
 {
   if(debugger.cartDebug().removeLabel(argStrings[0]))
   {
-    debugger.rom().invalidate();
+    debugger.invalidateRom();
     commandResult << argStrings[0] + " now undefined";
   }
   else
@@ -2266,7 +2300,7 @@ void DebuggerParser::executeWinds(bool unwind)
   uInt16 winds = unwind ? debugger.unwindStates(states, message) : debugger.rewindStates(states, message);
   if(winds > 0)
   {
-    debugger.rom().invalidate();
+    debugger.invalidateRom();
     commandResult << type << " by " << winds << " state" << (winds > 1 ? "s" : "");
     commandResult << " (~" << message << ")";
   }
@@ -2300,7 +2334,7 @@ void DebuggerParser::executeZ()
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // List of all commands available to the parser
-std::array<DebuggerParser::Command, 95> DebuggerParser::commands = { {
+std::array<DebuggerParser::Command, 101> DebuggerParser::commands = { {
   {
     "a",
     "Set Accumulator to <value>",
@@ -2482,6 +2516,17 @@ std::array<DebuggerParser::Command, 95> DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executeDebugColors)
   },
 
+  {
+    "decodetrace",
+    "Decode instruction trace [xx] to text",
+    "Writes <file>.txt, the default file is the one written by 'itrace'\n"
+    "Example: decodetrace, decodetrace mygame.trace",
+    false,
+    false,
+    { Parameters::ARG_FILE, Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeDecodetrace)
+  },
+
   {
     "define",
     "Define label xx for address yy",
@@ -2627,6 +2672,18 @@ std::array<DebuggerParser::Command, 95> DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executeHelp)
   },
 
+  {
+    "itrace",
+    "Trace all instructions: start/stop (0 or 1), or toggle (no arg)",
+    "Streams PC, bank, registers, scanline and bus addresses of each\n"
+    "instruction to a binary file (with default name), see 'decodetrace'\n"
+    "Example: itrace, itrace 0, itrace 1",
+    false,
+    false,
+    { Parameters::ARG_BOOL, Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeItrace)
+  },
+
   {
     "joy0up",
     "Set joystick 0 up direction to value <x> (0 or 1), or toggle (no arg)",
@@ -2797,6 +2854,17 @@ std::array<DebuggerParser::Command, 95> DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executeLoadconfig)
   },
 
+  {
+    "loadcoverage",
+    "Merge code coverage file(s) [xx ...] into the access flags",
+    "Example: loadcoverage, loadcoverage run1.cov run2.cov\n"
+    "NOTE: default file is in the default save location",
+    false,
+    true,
+    { Parameters::ARG_FILE, Parameters::ARG_MULTI_BYTE },
+    std::mem_fn(&DebuggerParser::executeLoadcoverage)
+  },
+
   {
     "loadallstates",
     "Load all emulator states",
@@ -2868,6 +2936,18 @@ std::array<DebuggerParser::Command, 95> DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executePrint)
   },
 
+  {
+    "profile",
+    "Profile CPU cycles: start/stop (0 or 1), or toggle (no arg)",
+    "Collects cycles per address and bank, and per scanline up to WSYNC\n"
+    "Starting discards previous results\n"
+    "Example: profile, profile 0, profile 1",
+    false,
+    false,
+    { Parameters::ARG_BOOL, Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeProfile)
+  },
+
   {
     "ram",
     "Show ZP RAM, or set address xx to yy1 [yy2 ...]",
@@ -2990,6 +3070,17 @@ std::array<DebuggerParser::Command, 95> DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executeSaveconfig)
   },
 
+  {
+    "savecoverage",
+    "Merge access flags into code coverage file [xx]",
+    "Example: savecoverage, savecoverage run1.cov\n"
+    "NOTE: default file is in the default save location",
+    false,
+    false,
+    { Parameters::ARG_FILE, Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeSavecoverage)
+  },
+
   {
     "savedis",
     "Save Distella disassembly (with default name)",
@@ -3001,6 +3092,17 @@ std::array<DebuggerParser::Command, 95> DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executeSavedisassembly)
   },
 
+  {
+    "saveprofile",
+    "Save cycle profile as text or CSV (with default name)",
+    "Example: saveprofile, saveprofile csv\n"
+    "NOTE: saves to default save location",
+    false,
+    false,
+    { Parameters::ARG_LABEL, Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeSaveprofile)
+  },
+
   {
     "saverom",
     "Save (possibly patched) ROM (with default name)",
@@ -97,7 +97,7 @@ class DebuggerParser
       std::array<Parameters, 10> parms;
       std::function<void (DebuggerParser*)> executor;
     };
-    static std::array<Command, 95> commands;
+    static std::array<Command, 101> commands;
 
     struct Trap
     {
@@ -159,6 +159,7 @@ class DebuggerParser
     void executeD();
     void executeData();
     void executeDebugColors();
+    void executeDecodetrace();
     void executeDefine();
     void executeDelbreakif();
     void executeDelfunction();
@@ -173,6 +174,7 @@ class DebuggerParser
     void executeFunction();
     void executeGfx();
     void executeHelp();
+    void executeItrace();
     void executeJoy0Up();
     void executeJoy0Down();
     void executeJoy0Left();
@@ -191,12 +193,14 @@ class DebuggerParser
     void executeListtraps();
     void executeLoadallstates();
     void executeLoadconfig();
+    void executeLoadcoverage();
     void executeLoadstate();
     void executeN();
     void executePalette();
     void executePc();
     void executePGfx();
     void executePrint();
+    void executeProfile();
     void executeRam();
     void executeReset();
     void executeRewind();
@@ -210,7 +214,9 @@ class DebuggerParser
     void executeSave();
     void executeSaveallstates();
     void executeSaveconfig();
+    void executeSavecoverage();
     void executeSavedisassembly();
+    void executeSaveprofile();
     void executeSaverom();
     void executeSaveses();
     void executeSavesnap();
@@ -228,7 +234,7 @@ class DebuggerParser
     void executeTrapwrite();
     void executeTrapwriteif();
     void executeTraps(bool read, bool write, const string& command, bool cond = false);
-    void executeTrapRW(uInt32 addr, bool read, bool write, bool add = true);  // not exposed by debugger
+    void executeTrapRW(uInt32 begin, uInt32 end, bool read, bool write, bool add = true);  // not exposed by debugger
     void executeType();
     void executeUHex();
     void executeUndef();
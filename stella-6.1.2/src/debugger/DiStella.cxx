@@ -1116,6 +1116,58 @@ void DiStella::processDirectives(const CartDebug::DirectiveList& directives)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string DiStella::disassemble(uInt16 pc, uInt8 opcode, const uInt8* operand)
+{
+  const Instruction_tag& instr = ourLookup[opcode];
+  const uInt16 ad = operand[0] | (operand[1] << 8);
+  ostringstream buf;
+
+  buf << std::setw(5) << std::left << std::setfill(' ') << instr.mnemonic;
+  switch(instr.addr_mode)
+  {
+    case AddressingMode::ACCUMULATOR:
+      buf << "A";
+      break;
+    case AddressingMode::IMMEDIATE:
+      buf << "#$" << Base::HEX2 << int(operand[0]);
+      break;
+    case AddressingMode::ZERO_PAGE:
+      buf << "$" << Base::HEX2 << int(operand[0]);
+      break;
+    case AddressingMode::ZERO_PAGE_X:
+      buf << "$" << Base::HEX2 << int(operand[0]) << ",x";
+      break;
+    case AddressingMode::ZERO_PAGE_Y:
+      buf << "$" << Base::HEX2 << int(operand[0]) << ",y";
+      break;
+    case AddressingMode::ABSOLUTE:
+      buf << "$" << Base::HEX4 << ad;
+      break;
+    case AddressingMode::ABSOLUTE_X:
+      buf << "$" << Base::HEX4 << ad << ",x";
+      break;
+    case AddressingMode::ABSOLUTE_Y:
+      buf << "$" << Base::HEX4 << ad << ",y";
+      break;
+    case AddressingMode::ABS_INDIRECT:
+      buf << "($" << Base::HEX4 << ad << ")";
+      break;
+    case AddressingMode::INDIRECT_X:
+      buf << "($" << Base::HEX2 << int(operand[0]) << ",x)";
+      break;
+    case AddressingMode::INDIRECT_Y:
+      buf << "($" << Base::HEX2 << int(operand[0]) << "),y";
+      break;
+    case AddressingMode::RELATIVE:
+      buf << "$" << Base::HEX4 << uInt16(pc + 2 + Int8(operand[0]));
+      break;
+    default:
+      break;
+  }
+  return buf.str();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 DiStella::Settings DiStella::settings;
 
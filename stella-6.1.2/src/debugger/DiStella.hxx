@@ -71,6 +71,23 @@ class DiStella
              CartDebug::AddrTypeArray& directives,
              CartDebug::ReservedEquates& reserved);
 
+    /**
+      Disassemble a single instruction without looking up any labels
+      (eg. for decoding instruction traces).
+
+      @param pc       The address of the opcode
+      @param opcode   The opcode
+      @param operand  The two bytes following the opcode
+
+      @return  The mnemonic and its operand
+    */
+    static string disassemble(uInt16 pc, uInt8 opcode, const uInt8* operand);
+
+    /**
+      The number of bytes of the instruction with the given opcode.
+    */
+    static uInt8 instructionSize(uInt8 opcode) { return ourLookup[opcode].bytes; }
+
   private:
     // Indicate that a new line of disassembly has been completed
     // In the original Distella code, this indicated a new line to be printed
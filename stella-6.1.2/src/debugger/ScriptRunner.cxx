@@ -0,0 +1,476 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <atomic>
+#include <thread>
+
+#include "MediaFactory.hxx"
+#include "OSystem.hxx"
+#include "Settings.hxx"
+#include "Logger.hxx"
+#include "FSNode.hxx"
+#include "MD5.hxx"
+#include "Console.hxx"
+#include "EmulationTiming.hxx"
+#include "Event.hxx"
+#include "EventHandler.hxx"
+#include "M6532.hxx"
+#include "TIA.hxx"
+#include "DispatchResult.hxx"
+#include "Debugger.hxx"
+#include "DebuggerParser.hxx"
+#include "CartDebug.hxx"
+#include "Expression.hxx"
+#include "YaccParser.hxx"
+#include "ScriptRunner.hxx"
+
+namespace {
+  // Limits the nesting of 'exec', in case a script runs itself
+  constexpr uInt32 MAX_EXEC_DEPTH = 16;
+
+  struct Input {
+    const char* name;
+    Event::Type event;
+  };
+  const std::array<Input, 18> INPUTS = { {
+    { "joy0up",    Event::JoystickZeroUp },
+    { "joy0down",  Event::JoystickZeroDown },
+    { "joy0left",  Event::JoystickZeroLeft },
+    { "joy0right", Event::JoystickZeroRight },
+    { "joy0fire",  Event::JoystickZeroFire },
+    { "joy1up",    Event::JoystickOneUp },
+    { "joy1down",  Event::JoystickOneDown },
+    { "joy1left",  Event::JoystickOneLeft },
+    { "joy1right", Event::JoystickOneRight },
+    { "joy1fire",  Event::JoystickOneFire },
+    { "reset",     Event::ConsoleReset },
+    { "select",    Event::ConsoleSelect },
+    { "color",     Event::ConsoleColor },
+    { "bw",        Event::ConsoleBlackWhite },
+    { "diff0a",    Event::ConsoleLeftDiffA },
+    { "diff0b",    Event::ConsoleLeftDiffB },
+    { "diff1a",    Event::ConsoleRightDiffA },
+    { "diff1b",    Event::ConsoleRightDiffB }
+  } };
+
+  // Prompt commands which need the debugger dialog or leave the debugger
+  const std::array<const char*, 6> DIALOG_COMMANDS = {
+    "cls", "exitrom", "jump", "run", "saveses", "savesnap"
+  };
+
+  string trim(const string& s)
+  {
+    const string::size_type first = s.find_first_not_of(" \t\r\n");
+
+    return first == string::npos ? EmptyString :
+        s.substr(first, s.find_last_not_of(" \t\r\n") - first + 1);
+  }
+
+  // Remove the color and inverse video codes meant for the prompt widget
+  string plainText(const string& s)
+  {
+    string text;
+
+    for(char c: s)
+      if(c == '\n' || (uInt8(c) >= 0x1e && uInt8(c) < 0x7f))
+        text += c;
+
+    return text;
+  }
+
+  string shellQuote(const string& arg)
+  {
+  #if defined(BSPF_WINDOWS)
+    return "\"" + arg + "\"";
+  #else
+    string quoted = "'";
+    for(char c: arg)
+      quoted += c == '\'' ? string("'\\''") : string(1, c);
+    return quoted + "'";
+  #endif
+  }
+
+  // Names in scripts are relative to the script, unless they only exist
+  // as given (ie, absolute paths)
+  FilesystemNode findFile(const string& name, const FilesystemNode& script)
+  {
+    FilesystemNode node(script.getParent().getPath() + name);
+
+    return node.exists() ? node : FilesystemNode(name);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ScriptRunner::ScriptRunner(int argc, char* argv[])
+  : myExecutable(argv[0])
+{
+  for(int i = 2; i < argc; ++i)
+  {
+    const string arg = argv[i];
+
+    if(arg == "-threads" && i + 1 < argc)
+      myThreads = std::max(BSPF::stringToInt(argv[++i]), 0);
+    else
+      myScripts.push_back(arg);
+  }
+
+  if(myThreads == 0)
+    myThreads = std::max(std::thread::hardware_concurrency(), 1U);
+  myThreads = std::min(myThreads, uInt32(myScripts.size()));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ScriptRunner::~ScriptRunner()
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ScriptRunner::run()
+{
+  if(myScripts.empty())
+  {
+    cerr << "usage: stella -script [-threads n] script..." << endl;
+    return false;
+  }
+
+  return myScripts.size() == 1 ? runScript(myScripts[0]) : runProcesses();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ScriptRunner::runProcesses()
+{
+  // std::vector<bool> can't be written from several threads
+  vector<uInt8> passed(myScripts.size(), false);
+  std::atomic<size_t> next{0};
+
+  const auto worker = [&]() {
+    for(size_t i = next++; i < myScripts.size(); i = next++)
+    {
+      string command = shellQuote(myExecutable) + " -script " +
+                       shellQuote(myScripts[i]);
+    #if defined(BSPF_WINDOWS)
+      // The shell removes the outer quotes
+      command = "\"" + command + "\"";
+    #endif
+      passed[i] = std::system(command.c_str()) == 0;
+    }
+  };
+
+  vector<std::thread> threads;
+  for(uInt32 i = 1; i < myThreads; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for(auto& thread: threads)
+    thread.join();
+
+  const size_t count = std::count(passed.begin(), passed.end(), true);
+  cout << count << " of " << myScripts.size() << " scripts passed" << endl;
+
+  return count == myScripts.size();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ScriptRunner::runScript(const string& scriptFile)
+{
+  FilesystemNode script(scriptFile);
+  bool passed = false;
+
+  myLocation = scriptFile;
+  if(!script.isFile())
+    error("not a script file");
+  else
+  {
+    // Scripts must run the same each time, so nothing may be random
+    // (the headless system also uses a constant random seed), nor depend
+    // on the local configuration or on earlier runs
+    OSystem::useDefaultConfig();
+    Settings::Options options;
+    options["dev.settings"] = false;
+    options["plr.ramrandom"] = false;
+    options["plr.bankrandom"] = false;
+    options["plr.cpurandom"] = "";
+    options["fastscbios"] = true;
+
+    myOSystem = MediaFactory::createOSystem();
+    myOSystem->loadConfig(options);
+
+    // Only errors may go to the console, the results are written there
+    Logger::instance().setLogParameters(Logger::Level::ERR, false);
+
+    if(!myOSystem->createHeadless())
+      error("couldn't create the system");
+    else
+      passed = execFile(script, scriptFile, 0) && !myFailed;
+  }
+
+  myOutput << scriptFile << (passed ? ": passed" : ": FAILED") << endl;
+  cout << myOutput.str();
+  cout.flush();
+
+  return passed;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ScriptRunner::execFile(const FilesystemNode& file, const string& name,
+                            uInt32 depth)
+{
+  ifstream in(file.getPath());
+  if(!in.is_open())
+    return error("script file '" + name + "' not found");
+
+  string line;
+  uInt32 lineNumber = 0;
+
+  while(getline(in, line))
+  {
+    ++lineNumber;
+    line = trim(line);
+    if(line.empty() || line[0] == '#')
+      continue;
+
+    myLocation = name + ":" + std::to_string(lineNumber);
+    if(!execCommand(line, file, depth))
+      return false;
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ScriptRunner::execCommand(const string& command, const FilesystemNode& file,
+                               uInt32 depth)
+{
+  const string::size_type split = command.find_first_of(" \t");
+  string verb = command.substr(0, split);
+  const string args = split == string::npos ? "" : trim(command.substr(split));
+
+  BSPF::toLowerCase(verb);
+
+  if(verb == "romfile")
+    return loadRom(findFile(args, file));
+
+  if(myDebugger == nullptr)
+    return error("no ROM loaded ('romfile' must come first)");
+
+  if(verb == "emulate")
+  {
+    const int frames = args.empty() ? 1 : BSPF::stringToInt(args);
+    if(frames <= 0)
+      return error("invalid number of frames");
+
+    return emulate(frames);
+  }
+  if(verb == "press" || verb == "release")
+    return setInputs(args, verb == "press");
+  if(verb == "assert")
+    return assertExpression(args);
+  if(verb == "assertbreak")
+  {
+    if(!myBreakHit)
+      fail("assertion failed: no break");
+    return true;
+  }
+  if(verb == "assertoutput")
+  {
+    if(args.empty())
+      return error("missing text");
+    if(myLastResult.find(args) == string::npos)
+      fail("assertion failed: output doesn't contain '" + args + "'");
+    return true;
+  }
+  if(verb == "framehash")
+    return frameHash(args);
+  if(verb == "exec")
+  {
+    // Unlike the prompt command, this allows script commands in the file
+    if(depth >= MAX_EXEC_DEPTH)
+      return error("'exec' nested too deeply");
+
+    const string location = myLocation;
+    const bool ok = execFile(findFile(args, file), args, depth + 1);
+    myLocation = location;
+
+    return ok;
+  }
+
+  for(const char* dialogCommand: DIALOG_COMMANDS)
+    if(verb == dialogCommand)
+      return error("'" + verb + "' isn't available in scripts");
+
+  const string result = myDebugger->run(command);
+  if(!result.empty() && result[0] == DebuggerParser::red()[0])
+    return error(plainText(result));
+
+  myLastResult = plainText(result);
+  print(myLastResult);
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ScriptRunner::loadRom(const FilesystemNode& rom)
+{
+  if(!rom.isFile())
+    return error("ROM file '" + rom.getShortPath() + "' not found");
+
+  // A ROM loaded before is replaced, together with its debugger
+  myDebugger = nullptr;
+  myLastResult = "";
+  const string message = myOSystem->createHeadlessConsole(rom);
+  if(message != EmptyString)
+    return error(message);
+
+  // Commands run 'inside' the debugger, as they do at its prompt
+  myDebugger = &myOSystem->debugger();
+  myDebugger->addBuiltinFunctions();
+  myDebugger->saveOldState();
+  myDebugger->setStartState();
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ScriptRunner::emulate(uInt32 frames)
+{
+  Console& console = myOSystem->console();
+  TIA& tia = console.tia();
+  DispatchResult dispatchResult;
+  dispatchResult.setOk(0);
+  myBreakHit = false;
+
+  // This also gets the CPU past a breakpoint it is sitting at
+  myDebugger->setQuitState();
+
+  for(uInt32 i = 0; i < frames; ++i)
+  {
+    // The controllers read their inputs once per frame
+    console.riot().update();
+
+    // Emulation is stopped at the end of each frame
+    const uInt32 frame = tia.frameCount();
+    do
+      tia.update(dispatchResult, console.emulationTiming().maxCyclesPerTimeslice());
+    while(dispatchResult.getStatus() == DispatchResult::Status::ok &&
+          tia.frameCount() == frame);
+
+    if(dispatchResult.getStatus() != DispatchResult::Status::ok)
+      break;
+  }
+  tia.renderToFrameBuffer();
+
+  myDebugger->setStartState();
+
+  switch(dispatchResult.getStatus())
+  {
+    case DispatchResult::Status::debugger:
+    {
+      ostringstream buf;
+      buf << "break in frame " << tia.frameCount() << ": "
+          << dispatchResult.getMessage();
+      if(dispatchResult.getAddress() > -1)
+        buf << myDebugger->cartDebug().getLabel(dispatchResult.getAddress(),
+                                                dispatchResult.wasReadTrap(), 4);
+      print(buf.str());
+      myBreakHit = true;
+      return true;
+    }
+
+    case DispatchResult::Status::fatal:
+      return error("emulation failed: " + dispatchResult.getMessage());
+
+    default:
+      return true;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ScriptRunner::setInputs(const string& inputs, bool pressed)
+{
+  EventHandler& eventHandler = myOSystem->eventHandler();
+  istringstream buf(inputs);
+  string name;
+
+  while(buf >> name)
+  {
+    BSPF::toLowerCase(name);
+
+    const auto input = std::find_if(INPUTS.begin(), INPUTS.end(),
+        [&](const Input& in) { return name == in.name; });
+    if(input == INPUTS.end())
+      return error("unknown input '" + name + "'");
+
+    eventHandler.handleEvent(input->event, pressed ? 1 : 0);
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ScriptRunner::assertExpression(const string& expression)
+{
+  // Allow the braces of the prompt commands, eg. 'breakif {...}'
+  string expr = expression;
+  if(expr.size() >= 2 && expr.front() == '{' && expr.back() == '}')
+    expr = expr.substr(1, expr.size() - 2);
+
+  if(expr.empty() || YaccParser::parse(expr) != 0)
+    return error("invalid expression: " + expression);
+
+  unique_ptr<Expression> result(YaccParser::getResult());
+  if(result->evaluate() == 0)
+    fail("assertion failed: " + expression);
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ScriptRunner::frameHash(const string& expected)
+{
+  TIA& tia = myOSystem->console().tia();
+  const string hash = MD5::hash(tia.frameBuffer(), tia.width() * tia.height());
+
+  if(expected.empty())
+    print("frame hash " + hash);
+  else if(!BSPF::equalsIgnoreCase(hash, expected))
+    fail("assertion failed: frame hash " + hash + " != " + expected);
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ScriptRunner::print(const string& message)
+{
+  istringstream buf(message);
+  string line;
+
+  while(getline(buf, line))
+    if(!trim(line).empty())
+      myOutput << myLocation << ": " << line << endl;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ScriptRunner::error(const string& message)
+{
+  print("error: " + message);
+  return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ScriptRunner::fail(const string& message)
+{
+  print(message);
+  myFailed = true;
+}
@@ -0,0 +1,119 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef SCRIPT_RUNNER_HXX
+#define SCRIPT_RUNNER_HXX
+
+class OSystem;
+class Debugger;
+class FilesystemNode;
+
+#include "bspf.hxx"
+
+/**
+  Runs debugger scripts without any display, sound or debugger dialog, eg.
+  as regression tests for ROMs.  Each line of a script is either a prompt
+  command of the debugger, or one of the following script commands:
+
+    romfile <file>        load the ROM (relative to the script), this must
+                          be done before any other command; loading a ROM
+                          again starts over with a new console and debugger
+    emulate [frames]      emulate 1 or more frames; stops early when a
+                          breakpoint, trap or breakif condition is hit
+    press <input>...      press or release joystick directions/buttons and
+    release <input>...    console switches (joy0up ... joy1fire, reset,
+                          select, color, bw, diff0a ... diff1b)
+    assert <expression>   fails unless the expression is true (non-zero)
+    assertbreak           fails unless the last 'emulate' stopped early
+    assertoutput <text>   fails unless the output of the last debugger
+                          command contains the text
+    framehash [md5]       prints the MD5 of the last frame, or fails unless
+                          it matches
+    exec <file>           runs the commands in another script
+
+  Lines starting with '#' are comments.  A script fails on the first error
+  (invalid command, missing file, etc.), or after running all commands when
+  an assertion failed.
+
+  There is only one debugger (and expression parser) per process, so each
+  of several scripts is run by a process of its own.  Scripts always run
+  with the default settings; no settings, properties or detection results
+  are loaded or stored.
+*/
+class ScriptRunner
+{
+  public:
+    ScriptRunner(int argc, char* argv[]);
+    ~ScriptRunner();
+
+    /**
+      Run all scripts and print the results.
+
+      @return  True if all scripts passed
+    */
+    bool run();
+
+  private:
+    // Run a single script in this process
+    bool runScript(const string& scriptFile);
+
+    // Run each script in a process of its own, several in parallel
+    bool runProcesses();
+
+    // Run the commands in the given file, stopping at the first error
+    bool execFile(const FilesystemNode& file, const string& name, uInt32 depth);
+    bool execCommand(const string& command, const FilesystemNode& file,
+                     uInt32 depth);
+
+    // The script commands; all return false on an error
+    bool loadRom(const FilesystemNode& rom);
+    bool emulate(uInt32 frames);
+    bool setInputs(const string& inputs, bool pressed);
+    bool assertExpression(const string& expression);
+    bool frameHash(const string& expected);
+
+    // Print the (possibly multi-line) message for the current command
+    void print(const string& message);
+    bool error(const string& message);
+    void fail(const string& message);
+
+  private:
+    string myExecutable;
+    StringList myScripts;
+    uInt32 myThreads{0};
+
+    unique_ptr<OSystem> myOSystem;
+    Debugger* myDebugger{nullptr};
+
+    // Output is written at once when the script is done, so the reports
+    // of scripts running in parallel don't mix
+    ostringstream myOutput;
+    string myLocation;  // file and line of the current command
+    bool myBreakHit{false};
+    string myLastResult;  // output of the last debugger command
+    bool myFailed{false};
+
+  private:
+    // Following constructors and assignment operators not supported
+    ScriptRunner() = delete;
+    ScriptRunner(const ScriptRunner&) = delete;
+    ScriptRunner(ScriptRunner&&) = delete;
+    ScriptRunner& operator=(const ScriptRunner&) = delete;
+    ScriptRunner& operator=(ScriptRunner&&) = delete;
+};
+
+#endif
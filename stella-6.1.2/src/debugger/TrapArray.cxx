@@ -0,0 +1,85 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "TrapArray.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TrapArray::add(const Range& range)
+{
+  myRanges.push_back(range);
+  setBits(range);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TrapArray::remove(const Range& range)
+{
+  const auto it = std::find(myRanges.begin(), myRanges.end(), range);
+  if(it == myRanges.end())
+    return;
+
+  myRanges.erase(it);
+
+  // Other ranges may overlap the removed one, so start from scratch
+  myBits.reset();
+  myPages.reset();
+  for(const auto& r: myRanges)
+    setBits(r);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TrapArray::clearAll()
+{
+  myRanges.clear();
+  myBits.reset();
+  myPages.reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TrapArray::setBits(const Range& range)
+{
+  for(uInt32 addr = 0; addr <= 0xFFFF; ++addr)
+    if(range.contains(addr))
+    {
+      myBits.set(addr);
+      myPages.set(addr >> PAGE_SHIFT);
+    }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TrapArray::addMirrors(RangeList& list, uInt16 begin, uInt16 end,
+                           uInt16 fixedMask, uInt16 fixedValue, uInt16 mask)
+{
+  const auto append = [&](uInt16 lo, uInt16 hi) {
+    Range range;
+    range.fixedMask = fixedMask;  range.fixedValue = fixedValue;
+    range.mask = mask;  range.lo = lo;  range.hi = hi;
+
+    if(std::find(list.begin(), list.end(), range) == list.end())
+      list.push_back(range);
+  };
+
+  if(end - begin >= mask)
+    append(0, mask);
+  else if((begin & mask) <= (end & mask))
+    append(begin & mask, end & mask);
+  else
+  {
+    // The range wraps around within the mirrored bits
+    append(begin & mask, mask);
+    append(0, end & mask);
+  }
+}
@@ -18,35 +18,81 @@
 #ifndef TRAP_ARRAY_HXX
 #define TRAP_ARRAY_HXX
 
+#include <bitset>
+
 #include "bspf.hxx"
 
+/**
+  The addresses which trigger a read or write trap.
+
+  Traps are stored as ranges which include all their mirrors, so that
+  even traps covering the whole TIA or RIOT space need no per-address
+  bookkeeping.  For the checks during emulation, the ranges are combined
+  into a bitset, plus one summary bit per page, so accesses to pages
+  without any trap are rejected with a single test.
+*/
 class TrapArray
 {
   public:
-    TrapArray() = default;
+    /**
+      All addresses whose bits in 'fixedMask' equal 'fixedValue', and whose
+      bits in 'mask' lie within 'lo' and 'hi' (inclusive).
+    */
+    struct Range
+    {
+      uInt16 fixedMask{0}, fixedValue{0};
+      uInt16 mask{0xFFFF}, lo{0}, hi{0};
 
-    bool isSet(const uInt16 address) const { return myCount[address]; }
-    bool isClear(const uInt16 address) const { return myCount[address] == 0; }
+      bool contains(uInt16 address) const {
+        const uInt16 bits = address & mask;
+        return (address & fixedMask) == fixedValue && bits >= lo && bits <= hi;
+      }
 
-    void add(const uInt16 address) { myCount[address]++; }
-    void remove(const uInt16 address) { myCount[address]--; }
-    // void toggle(uInt16 address) { myCount[address] ? remove(address) : add(address); } // TODO condition
+      bool operator==(const Range& other) const {
+        return fixedMask == other.fixedMask && fixedValue == other.fixedValue &&
+               mask == other.mask && lo == other.lo && hi == other.hi;
+      }
+    };
+    using RangeList = std::vector<Range>;
+
+    TrapArray() = default;
 
-    void initialize() {
-      if(!myInitialized)
-        myCount.fill(0);
-      myInitialized = true;
+    bool isSet(const uInt16 address) const {
+      return myPages[address >> PAGE_SHIFT] && myBits[address];
     }
-    void clearAll() { myInitialized = false; myCount.fill(0); }
+    bool isEmpty() const { return myRanges.empty(); }
 
-    bool isInitialized() const { return myInitialized; }
+    /**
+      Add/remove a range; ranges are counted, so a range added twice must
+      also be removed twice.
+    */
+    void add(const Range& range);
+    void remove(const Range& range);
+
+    void clearAll();
+
+    /**
+      Append the ranges covering the addresses 'begin' to 'end', mirrored
+      over all addresses matching 'fixedMask'/'fixedValue'; only the bits
+      in 'mask' distinguish the addresses.  Ranges already in the list
+      are not added again.
+    */
+    static void addMirrors(RangeList& list, uInt16 begin, uInt16 end,
+                           uInt16 fixedMask, uInt16 fixedValue, uInt16 mask);
 
   private:
-    // The actual counts
-    std::array<uInt8, 0x10000> myCount;
+    // Set the bits of all addresses within the range
+    void setBits(const Range& range);
+
+  private:
+    static constexpr uInt32 PAGE_SHIFT = 8;
+
+    // The ranges, as added
+    RangeList myRanges;
 
-    // Indicates whether we should treat this array as initialized
-    bool myInitialized{false};
+    // One bit per address, and one per page with any bit set
+    std::bitset<0x10000> myBits;
+    std::bitset<(0x10000 >> PAGE_SHIFT)> myPages;
 
   private:
     // Following constructors and assignment operators not supported
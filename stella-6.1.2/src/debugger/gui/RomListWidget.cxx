@@ -17,6 +17,7 @@
 
 #include "bspf.hxx"
 #include "Debugger.hxx"
+#include "CycleProfiler.hxx"
 #include "DiStella.hxx"
 #include "Widget.hxx"
 #include "StellaKeys.hxx"
@@ -476,15 +477,25 @@ void RomListWidget::drawWidget(bool hilite)
   if(actualWidth < codeDisasmW)
     codeDisasmW = actualWidth;
 
+  // The profiler heat is shown relative to the hottest instruction
+  CartDebug& cartdbg = instance().debugger().cartDebug();
+  const CycleProfiler* profiler = instance().debugger().profiler();
+  uInt64 maxCycles = 0;
+  if(profiler)
+    for(const auto& line: dlist)
+      if(line.type == CartDebug::CODE)
+        maxCycles = std::max(maxCycles,
+                             profiler->cycles(line.address, cartdbg.getBank(line.address)));
+
   xpos = _x + CheckboxWidget::boxSize() + 10;  ypos = _y + 2;
   for (i = 0, pos = _currentPos; i < _rows && pos < len; i++, pos++, ypos += _fontHeight)
   {
     ColorId bytesColor = textColor;
+    int bank = cartdbg.getBank(dlist[pos].address);
 
     // Draw checkboxes for correct lines (takes scrolling into account)
     myCheckList[i]->setState(instance().debugger().
-                             checkBreakPoint(dlist[pos].address,
-                             instance().debugger().cartDebug().getBank(dlist[pos].address)));
+                             checkBreakPoint(dlist[pos].address, bank));
 
     myCheckList[i]->setDirty();
     myCheckList[i]->draw();
@@ -522,7 +533,15 @@ void RomListWidget::drawWidget(bool hilite)
         if (dlist[pos].disasm.length() > 8)
           s.drawString(_font, dlist[pos].disasm.substr(8), xpos + _labelWidth + 7 * _fontWidth, ypos,
                        codeDisasmW - 7 * _fontWidth, textColor);
-        // Draw cycle count
+        // Draw profiler heat and cycle count
+        if(maxCycles)
+        {
+          uInt64 cycles = profiler->cycles(dlist[pos].address, bank);
+          if(cycles)
+            s.fillRect(xpos + _labelWidth + codeDisasmW, ypos - 1,
+                       std::max(1, int(cycleCountW * cycles / maxCycles)),
+                       _fontHeight, kDbgChangedColor);
+        }
         s.drawString(_font, dlist[pos].ccount, xpos + _labelWidth + codeDisasmW, ypos,
                      cycleCountW, textColor);
       }
@@ -5,10 +5,14 @@ MODULE_OBJS := \
         src/debugger/Debugger.o \
         src/debugger/DebuggerParser.o \
         src/debugger/CartDebug.o \
+        src/debugger/CodeCoverage.o \
         src/debugger/CpuDebug.o \
+        src/debugger/CycleProfiler.o \
         src/debugger/DiStella.o \
         src/debugger/RiotDebug.o \
-        src/debugger/TIADebug.o
+        src/debugger/ScriptRunner.o \
+        src/debugger/TIADebug.o \
+        src/debugger/TrapArray.o
 
 MODULE_DIRS += \
         src/debugger
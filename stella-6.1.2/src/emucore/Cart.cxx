@@ -18,6 +18,7 @@
 #include "Settings.hxx"
 #include "System.hxx"
 #include "MD5.hxx"
+#include "SharedRom.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "Debugger.hxx"
   #include "CartDebug.hxx"
@@ -68,6 +69,21 @@ bool Cartridge::saveROM(ofstream& out) const
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Cartridge::reload(const ByteBuffer& image, size_t size)
+{
+  size_t romSize = 0;
+
+  // The image is only exposed read-only, but is owned by the cart
+  uInt8* rom = const_cast<uInt8*>(getImage(romSize));
+  if(rom == nullptr || romSize != size)
+    return false;
+
+  std::copy_n(image.get(), size, rom);
+
+  return myBankChanged = true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Cartridge::bankChanged()
 {
@@ -118,12 +134,46 @@ void Cartridge::createCodeAccessBase(size_t size)
 {
 #ifdef DEBUGGER_SUPPORT
   myCodeAccessBase = make_unique<uInt8[]>(size);
+  myCodeAccessSize = size;
   std::fill_n(myCodeAccessBase.get(), size, CartDebug::ROW);
 #else
   myCodeAccessBase = nullptr;
 #endif
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt8* Cartridge::makeImageUnique(SharedRom& image)
+{
+  const uInt8* oldImage = image.data();
+  uInt8* newImage = image.makeUnique();
+
+  if(newImage != oldImage && mySystem)
+  {
+    for(uInt16 addr = 0x1000; addr < 0x2000; addr += System::PAGE_SIZE)
+    {
+      System::PageAccess access = mySystem->getPageAccess(addr);
+      if(access.device == this && access.directPeekBase >= oldImage &&
+         access.directPeekBase < oldImage + image.size())
+      {
+        access.directPeekBase = newImage + (access.directPeekBase - oldImage);
+        mySystem->setPageAccess(addr, access);
+      }
+    }
+  }
+  return newImage;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Cartridge::reloadImage(SharedRom& rom, const ByteBuffer& image, size_t size)
+{
+  if(size != rom.size())
+    return false;
+
+  std::copy_n(image.get(), size, makeImageUnique(rom));
+
+  return myBankChanged = true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Cartridge::initializeRAM(uInt8* arr, size_t size, uInt8 val) const
 {
@@ -23,6 +23,7 @@ class Properties;
 class CartDebugWidget;
 class CartRamWidget;
 class GuiObject;
+class SharedRom;
 
 #include "bspf.hxx"
 #include "Device.hxx"
@@ -135,6 +136,18 @@ class Cartridge : public Device
       @return  Address of illegal access if one occurred, else 0
     */
     uInt16 getIllegalRAMWriteAccess() const { return myRamWriteAccess; }
+
+    /**
+      Access the code-access information for every byte of the ROM (and
+      possibly cart RAM), as created by createCodeAccessBase().
+
+      @param size  Set to the size of the code-access array
+      @return  A pointer to the code-access array
+    */
+    uInt8* getCodeAccessBase(size_t& size) const {
+      size = myCodeAccessSize;
+      return myCodeAccessBase.get();
+    }
   #endif
 
   public:
@@ -194,6 +207,23 @@ class Cartridge : public Device
     */
     virtual const uInt8* getImage(size_t& size) const = 0;
 
+    /**
+      Replace the ROM image with a new one of the same size and scheme
+      (eg. a rebuilt version of the same ROM), keeping the bankswitching
+      state and any cart RAM.
+
+      The default implementation copies the new image over the one returned
+      by getImage(), which is the image mapped directly into the system for
+      most schemes.  Carts which derive more state from their image, or
+      share it with other cartridges (see reloadImage()), must override
+      this.
+
+      @param image  The new ROM image
+      @param size   The size of the new ROM image
+      @return  False if the image can't be replaced this way
+    */
+    virtual bool reload(const ByteBuffer& image, size_t size);
+
     /**
       Get a descriptor for the cart name.
 
@@ -275,6 +305,28 @@ class Cartridge : public Device
     */
     void createCodeAccessBase(size_t size);
 
+    /**
+      Get a writable pointer to the given ROM image (e.g. for patching it),
+      copying it first if it is shared with other cartridges.  Pages which
+      read directly from the image are moved to the copy.
+
+      @param image  The ROM image of the cartridge
+      @return  A pointer to the (now private) ROM image data
+    */
+    uInt8* makeImageUnique(SharedRom& image);
+
+    /**
+      Replace the given ROM image with a new one of the same size, see
+      reload().  The image is made private to this cartridge first, so
+      other cartridges sharing it keep the old one.
+
+      @param rom    The ROM image of the cartridge
+      @param image  The new ROM image
+      @param size   The size of the new ROM image
+      @return  False if the sizes differ
+    */
+    bool reloadImage(SharedRom& rom, const ByteBuffer& image, size_t size);
+
     /**
       Fill the given RAM array with (possibly random) data.
 
@@ -323,6 +375,7 @@ class Cartridge : public Device
     // The array containing information about every byte of ROM indicating
     // whether it is used as code.
     ByteBuffer myCodeAccessBase;
+    size_t myCodeAccessSize{0};
 
     // Contains address of illegal RAM write access or 0
     uInt16 myRamWriteAccess{0};
@@ -21,10 +21,9 @@
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Cartridge0840::Cartridge0840(const ByteBuffer& image, size_t size,
                              const string& md5, const Settings& settings)
-  : Cartridge(settings, md5)
+  : Cartridge(settings, md5),
+    myImage(md5, image.get(), size, 8_KB)
 {
-  // Copy the ROM image into my buffer
-  std::copy_n(image.get(), std::min(myImage.size(), size), myImage.begin());
   createCodeAccessBase(myImage.size());
 }
 
@@ -158,7 +157,7 @@ uInt16 Cartridge0840::bankCount() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Cartridge0840::patch(uInt16 address, uInt8 value)
 {
-  myImage[myBankOffset + (address & 0x0fff)] = value;
+  makeImageUnique(myImage)[myBankOffset + (address & 0x0fff)] = value;
   return myBankChanged = true;
 }
 
@@ -22,6 +22,7 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "SharedRom.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "Cart4KWidget.hxx"
 #endif
@@ -80,6 +81,18 @@ class Cartridge4K : public Cartridge
     */
     const uInt8* getImage(size_t& size) const override;
 
+    /**
+      Replace the ROM image, see Cartridge::reload().  The image may be
+      shared with other consoles, so this cart gets a copy of its own.
+
+      @param image  The new ROM image
+      @param size   The size of the new ROM image
+      @return  False if the image can't be replaced this way
+    */
+    bool reload(const ByteBuffer& image, size_t size) override {
+      return reloadImage(myImage, image, size);
+    }
+
     /**
       Save the current state of this cart to the given Serializer.
 
@@ -124,7 +137,7 @@ class Cartridge4K : public Cartridge
 
   private:
     // The 4K ROM image for the cartridge
-    std::array<uInt8, 4_KB> myImage;
+    SharedRom myImage;
 
   private:
     // Following constructors and assignment operators not supported
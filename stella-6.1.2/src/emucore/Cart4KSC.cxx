@@ -21,10 +21,9 @@
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Cartridge4KSC::Cartridge4KSC(const ByteBuffer& image, size_t size,
                              const string& md5, const Settings& settings)
-  : Cartridge(settings, md5)
+  : Cartridge(settings, md5),
+    myImage(md5, image.get(), size, 4_KB)
 {
-  // Copy the ROM image into my buffer
-  std::copy_n(image.get(), std::min(myImage.size(), size), myImage.begin());
   createCodeAccessBase(myImage.size());
 }
 
@@ -112,7 +111,7 @@ bool Cartridge4KSC::patch(uInt16 address, uInt8 value)
     myRAM[address & 0x007F] = value;
   }
   else
-    myImage[address & 0xFFF] = value;
+    makeImageUnique(myImage)[address & 0xFFF] = value;
 
   return myBankChanged = true;
 }
@@ -35,6 +35,8 @@ CartridgeAR::CartridgeAR(const ByteBuffer& image, size_t size,
     std::copy_n(ourDefaultHeader.data(), ourDefaultHeader.size(),
                 myLoadImages.get()+myImage.size());
 
+  buildLoadIndex();
+
   // We use System::PageAccess.codeAccessBase, but don't allow its use
   // through a pointer, since the AR scheme doesn't support bankswitching
   // in the normal sense
@@ -324,7 +326,7 @@ void CartridgeAR::initializeROM()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8 CartridgeAR::checksum(uInt8* s, uInt16 length)
+uInt8 CartridgeAR::checksum(const uInt8* s, uInt16 length) const
 {
   uInt8 sum = 0;
 
@@ -335,57 +337,75 @@ uInt8 CartridgeAR::checksum(uInt8* s, uInt16 length)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void CartridgeAR::loadIntoRAM(uInt8 load)
+void CartridgeAR::buildLoadIndex()
 {
-  uInt16 image;
+  bool invalidHeaderChecksumSeen = false, invalidPageChecksumSeen = false;
 
-  // Scan through all of the loads to see if we find the one we're looking for
-  for(image = 0; image < myNumberOfLoadImages; ++image)
+  myLoadIndex.fill(NO_LOAD);
+  for(uInt8 image = 0; image < myNumberOfLoadImages; ++image)
   {
-    // Is this the correct load?
-    if(myLoadImages[(image * 8448) + myImage.size() + 5] == load)
-    {
-      // Copy the load's header
-      std::copy_n(myLoadImages.get() + (image * 8448) + myImage.size(), myHeader.size(), myHeader.data());
+    const uInt8* src = myLoadImages.get() + (image * 8448);
+    const uInt8* header = src + myImage.size();
 
-      // Verify the load's header
-      if(checksum(myHeader.data(), 8) != 0x55)
-        cerr << "WARNING: The Supercharger header checksum is invalid...\n";
+    // Multiple loads with the same number are allowed, but only the first
+    // one can ever be loaded
+    if(myLoadIndex[header[5]] == NO_LOAD)
+      myLoadIndex[header[5]] = image;
 
-      // Load all of the pages from the load
-      bool invalidPageChecksumSeen = false;
-      for(uInt32 j = 0; j < myHeader[3]; ++j)
+    // Verify the load's header and pages once, instead of on each load
+    if(!invalidHeaderChecksumSeen && checksum(header, 8) != 0x55)
+    {
+      cerr << "WARNING: The Supercharger header checksum is invalid...\n";
+      invalidHeaderChecksumSeen = true;
+    }
+    const uInt32 pages = std::min<uInt32>(header[3], 32);
+    for(uInt32 j = 0; j < pages && !invalidPageChecksumSeen; ++j)
+    {
+      uInt8 sum = checksum(src + (j * 256), 256) + header[16 + j] + header[64 + j];
+      if(sum != 0x55)
       {
-        uInt32 bank = myHeader[16 + j] & 0x03;
-        uInt32 page = (myHeader[16 + j] >> 2) & 0x07;
-        uInt8* src = myLoadImages.get() + (image * 8448) + (j * 256);
-        uInt8 sum = checksum(src, 256) + myHeader[16 + j] + myHeader[64 + j];
-
-        if(!invalidPageChecksumSeen && (sum != 0x55))
-        {
-          cerr << "WARNING: Some Supercharger page checksums are invalid...\n";
-          invalidPageChecksumSeen = true;
-        }
-
-        // Copy page to Supercharger RAM (don't allow a copy into ROM area)
-        if(bank < 3)
-          std::copy_n(src, 256, myImage.data() + (bank * 2048) + (page * 256));
+        cerr << "WARNING: Some Supercharger page checksums are invalid...\n";
+        invalidPageChecksumSeen = true;
       }
+    }
+  }
+}
 
-      // Copy the bank switching byte and starting address into the 2600's
-      // RAM for the "dummy" SC BIOS to access it
-      mySystem->poke(0xfe, myHeader[0]);
-      mySystem->poke(0xff, myHeader[1]);
-      mySystem->poke(0x80, myHeader[2]);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeAR::loadIntoRAM(uInt8 load)
+{
+  const uInt8 image = myLoadIndex[load];
+  if(image == NO_LOAD)
+  {
+    // TODO: Should probably switch to an internal ROM routine to display
+    // this message to the user...
+    cerr << "ERROR: Supercharger load is missing from ROM image...\n";
+    return;
+  }
+  const uInt8* src = myLoadImages.get() + (image * 8448);
 
-      myBankChanged = true;
-      return;
-    }
+  // Copy the load's header
+  std::copy_n(src + myImage.size(), myHeader.size(), myHeader.data());
+
+  // Load all of the pages from the load (an image can't hold more than 32)
+  const uInt32 pages = std::min<uInt32>(myHeader[3], 32);
+  for(uInt32 j = 0; j < pages; ++j)
+  {
+    uInt32 bank = myHeader[16 + j] & 0x03;
+    uInt32 page = (myHeader[16 + j] >> 2) & 0x07;
+
+    // Copy page to Supercharger RAM (don't allow a copy into ROM area)
+    if(bank < 3)
+      std::copy_n(src + (j * 256), 256, myImage.data() + (bank * 2048) + (page * 256));
   }
 
-  // TODO: Should probably switch to an internal ROM routine to display
-  // this message to the user...
-  cerr << "ERROR: Supercharger load is missing from ROM image...\n";
+  // Copy the bank switching byte and starting address into the 2600's
+  // RAM for the "dummy" SC BIOS to access it
+  mySystem->poke(0xfe, myHeader[0]);
+  mySystem->poke(0xff, myHeader[1]);
+  mySystem->poke(0x80, myHeader[2]);
+
+  myBankChanged = true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -106,6 +106,13 @@ class CartridgeAR : public Cartridge
     */
     const uInt8* getImage(size_t& size) const override;
 
+    /**
+      Not supported, since the loads are copied into RAM when loading.
+
+      @return  Always false
+    */
+    bool reload(const ByteBuffer&, size_t) override { return false; }
+
     /**
       Save the current state of this cart to the given Serializer.
 
@@ -177,7 +184,10 @@ class CartridgeAR : public Cartridge
     bool bankConfiguration(uInt8 configuration);
 
     // Compute the sum of the array of bytes
-    uInt8 checksum(uInt8* s, uInt16 length);
+    uInt8 checksum(const uInt8* s, uInt16 length) const;
+
+    // Build the table of the loads in the image, and verify their checksums
+    void buildLoadIndex();
 
     // Load the specified load into SC RAM
     void loadIntoRAM(uInt8 load);
@@ -204,6 +214,11 @@ class CartridgeAR : public Cartridge
     // Indicates how many 8448 loads there are
     uInt8 myNumberOfLoadImages{0};
 
+    // The index of the 8448 byte load for each load number (the first
+    // one, as the BIOS would find it), or NO_LOAD if there is none
+    std::array<uInt8, 256> myLoadIndex;
+    static constexpr uInt8 NO_LOAD = 0xFF;
+
     // Indicates if the RAM is write enabled
     bool myWriteEnabled{false};
 
@@ -43,11 +43,9 @@
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 CartridgeBUS::CartridgeBUS(const ByteBuffer& image, size_t size,
                            const string& md5, const Settings& settings)
-  : Cartridge(settings, md5)
+  : Cartridge(settings, md5),
+    myImage(md5, image.get(), size, 32_KB)
 {
-  // Copy the ROM image into my buffer
-  std::copy_n(image.get(), std::min(myImage.size(), size), myImage.begin());
-
   // Even though the ROM is 32K, only 28K is accessible to the 6507
   createCodeAccessBase(28_KB);
 
@@ -64,7 +62,7 @@ CartridgeBUS::CartridgeBUS(const ByteBuffer& image, size_t size,
   // Create Thumbulator ARM emulator
   bool devSettings = settings.getBool("dev.settings");
   myThumbEmulator = make_unique<Thumbulator>(
-    reinterpret_cast<uInt16*>(myImage.data()),
+    reinterpret_cast<const uInt16*>(myImage.data()),
     reinterpret_cast<uInt16*>(myBUSRAM.data()),
     static_cast<uInt32>(myImage.size()),
     devSettings ? settings.getBool("dev.thumb.trapfatal") : false, Thumbulator::ConfigureFor::BUS, this
@@ -83,7 +81,7 @@ void CartridgeBUS::reset()
 
   // Update cycles to the current system cycles
   myAudioCycles = myARMCycles = 0;
-  myFractionalClocks = 0.0;
+  myMusicClock.reset();
 
   setInitialState();
 
@@ -95,7 +93,7 @@ void CartridgeBUS::reset()
 void CartridgeBUS::setInitialState()
 {
   // Copy initial BUS driver to Harmony RAM
-  std::copy_n(myImage.begin(), 2_KB, myBusDriverImage);
+  std::copy_n(myImage.data(), 2_KB, myBusDriverImage);
 
   myMusicWaveformSize.fill(27);
 
@@ -142,9 +140,7 @@ inline void CartridgeBUS::updateMusicModeDataFetchers()
   myAudioCycles = mySystem->cycles();
 
   // Calculate the number of BUS OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = myMusicClock.advance(cycles);
 
   // Let's update counters and flags of the music mode data fetchers
   if(wholeClocks > 0)
@@ -165,7 +161,8 @@ inline void CartridgeBUS::callFunction(uInt8 value)
         Int32 cycles = Int32(mySystem->cycles() - myARMCycles);
         myARMCycles = mySystem->cycles();
 
-        myThumbEmulator->run(cycles);
+        if(myThumbEmulator->call(cycles) == Thumbulator::Status::aborted)
+          throw runtime_error("ARM code did not return");
       }
       catch(const runtime_error& e) {
         if(!mySystem->autodetectMode())
@@ -468,7 +465,14 @@ bool CartridgeBUS::patch(uInt16 address, uInt8 value)
   // For now, we ignore attempts to patch the BUS address space
   if(address >= 0x0040)
   {
-    myProgramImage[myBankOffset + (address & 0x0FFF)] = value;
+    // The image may be shared with other cartridges, so patch a copy
+    uInt8* image = myImage.makeUnique();
+    if(image + 4_KB != myProgramImage)
+    {
+      myProgramImage = image + 4_KB;
+      myThumbEmulator->setRom(reinterpret_cast<const uInt16*>(image));
+    }
+    image[4_KB + myBankOffset + (address & 0x0FFF)] = value;
     return myBankChanged = true;
   }
   else
@@ -559,7 +563,7 @@ bool CartridgeBUS::save(Serializer& out) const
 
     // Save cycles and clocks
     out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    out.putDouble(myMusicClock.fraction());
     out.putLong(myARMCycles);
 
     // Audio info
@@ -600,7 +604,7 @@ bool CartridgeBUS::load(Serializer& in)
 
     // Get system cycles and fractional clocks
     myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    myMusicClock.setFraction(in.getDouble());
     myARMCycles = in.getLong();
 
     // Audio info
@@ -26,6 +26,8 @@ class Thumbulator;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "SharedRom.hxx"
+#include "MusicClock.hxx"
 
 /**
   Cartridge class used for BUS.
@@ -117,6 +119,14 @@ class CartridgeBUS : public Cartridge
     */
     const uInt8* getImage(size_t& size) const override;
 
+    /**
+      Not supported, since the image is shared with other consoles, and
+      the ARM driver runs from a copy in RAM.
+
+      @return  Always false
+    */
+    bool reload(const ByteBuffer&, size_t) override { return false; }
+
     /**
       Save the current state of this cart to the given Serializer.
 
@@ -211,10 +221,10 @@ class CartridgeBUS : public Cartridge
 
   private:
     // The 32K ROM image of the cartridge
-    std::array<uInt8, 32_KB> myImage;
+    SharedRom myImage;
 
     // Pointer to the 28K program ROM image of the cartridge
-    uInt8* myProgramImage{nullptr};
+    const uInt8* myProgramImage{nullptr};
 
     // Pointer to the 4K display ROM image of the cartridge
     uInt8* myDisplayImage{nullptr};
@@ -259,8 +269,8 @@ class CartridgeBUS : public Cartridge
     // The music waveform sizes
     std::array<uInt8, 3> myMusicWaveformSize{0};
 
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks{0.0};
+    // Music OSC, with the fractional clock unused during the last update
+    MusicClock myMusicClock;
 
     // Controls mode, lower nybble sets Fast Fetch, upper nybble sets audio
     // -0 = Bus Stuffing ON
@@ -59,11 +59,9 @@ namespace {
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 CartridgeCDF::CartridgeCDF(const ByteBuffer& image, size_t size,
                            const string& md5, const Settings& settings)
-  : Cartridge(settings, md5)
+  : Cartridge(settings, md5),
+    myImage(md5, image.get(), size, 32_KB)
 {
-  // Copy the ROM image into my buffer
-  std::copy_n(image.get(), std::min(myImage.size(), size), myImage.begin());
-
   // even though the ROM is 32K, only 28K is accessible to the 6507
   createCodeAccessBase(28_KB);
 
@@ -82,7 +80,7 @@ CartridgeCDF::CartridgeCDF(const ByteBuffer& image, size_t size,
   // Create Thumbulator ARM emulator
   bool devSettings = settings.getBool("dev.settings");
   myThumbEmulator = make_unique<Thumbulator>(
-    reinterpret_cast<uInt16*>(myImage.data()),
+    reinterpret_cast<const uInt16*>(myImage.data()),
     reinterpret_cast<uInt16*>(myCDFRAM.data()),
     static_cast<uInt32>(myImage.size()),
     devSettings ? settings.getBool("dev.thumb.trapfatal") : false, thumulatorConfiguration(myCDFSubtype), this);
@@ -99,7 +97,7 @@ void CartridgeCDF::reset()
   initializeStartBank(6);
 
   myAudioCycles = myARMCycles = 0;
-  myFractionalClocks = 0.0;
+  myMusicClock.reset();
 
   setInitialState();
 
@@ -111,7 +109,7 @@ void CartridgeCDF::reset()
 void CartridgeCDF::setInitialState()
 {
   // Copy initial CDF driver to Harmony RAM
-  std::copy_n(myImage.begin(), 2_KB, myBusDriverImage);
+  std::copy_n(myImage.data(), 2_KB, myBusDriverImage);
 
   myMusicWaveformSize.fill(27);
 
@@ -152,9 +150,7 @@ inline void CartridgeCDF::updateMusicModeDataFetchers()
   myAudioCycles = mySystem->cycles();
 
   // Calculate the number of CDF OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = myMusicClock.advance(cycles);
 
   // Let's update counters and flags of the music mode data fetchers
   if(wholeClocks > 0)
@@ -175,7 +171,8 @@ inline void CartridgeCDF::callFunction(uInt8 value)
         Int32 cycles = Int32(mySystem->cycles() - myARMCycles);
         myARMCycles = mySystem->cycles();
 
-        myThumbEmulator->run(cycles);
+        if(myThumbEmulator->call(cycles) == Thumbulator::Status::aborted)
+          throw runtime_error("ARM code did not return");
       }
       catch(const runtime_error& e) {
         if(!mySystem->autodetectMode())
@@ -441,7 +438,14 @@ bool CartridgeCDF::patch(uInt16 address, uInt8 value)
   // For now, we ignore attempts to patch the CDF address space
   if(address >= 0x0040)
   {
-    myProgramImage[myBankOffset + (address & 0x0FFF)] = value;
+    // The image may be shared with other cartridges, so patch a copy
+    uInt8* image = myImage.makeUnique();
+    if(image + 4_KB != myProgramImage)
+    {
+      myProgramImage = image + 4_KB;
+      myThumbEmulator->setRom(reinterpret_cast<const uInt16*>(image));
+    }
+    image[4_KB + myBankOffset + (address & 0x0FFF)] = value;
     return myBankChanged = true;
   }
   else
@@ -515,7 +519,7 @@ bool CartridgeCDF::save(Serializer& out) const
 
     // Save cycles and clocks
     out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    out.putDouble(myMusicClock.fraction());
     out.putLong(myARMCycles);
   }
   catch(...)
@@ -555,7 +559,7 @@ bool CartridgeCDF::load(Serializer& in)
 
     // Get cycles and clocks
     myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    myMusicClock.setFraction(in.getDouble());
     myARMCycles = in.getLong();
   }
   catch(...)
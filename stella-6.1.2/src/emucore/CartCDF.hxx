@@ -23,6 +23,8 @@ class Thumbulator;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "SharedRom.hxx"
+#include "MusicClock.hxx"
 
 /**
   Cartridge class used for CDF.
@@ -123,6 +125,14 @@ class CartridgeCDF : public Cartridge
     */
     const uInt8* getImage(size_t& size) const override;
 
+    /**
+      Not supported, since the image is shared with other consoles, and
+      the ARM driver runs from a copy in RAM.
+
+      @return  Always false
+    */
+    bool reload(const ByteBuffer&, size_t) override { return false; }
+
     /**
       Save the current state of this cart to the given Serializer.
 
@@ -211,10 +221,10 @@ class CartridgeCDF : public Cartridge
 
   private:
     // The 32K ROM image of the cartridge
-    std::array<uInt8, 32_KB> myImage;
+    SharedRom myImage;
 
     // Pointer to the 28K program ROM image of the cartridge
-    uInt8* myProgramImage{nullptr};
+    const uInt8* myProgramImage{nullptr};
 
     // Pointer to the 4K display ROM image of the cartridge
     uInt8* myDisplayImage{nullptr};
@@ -265,8 +275,8 @@ class CartridgeCDF : public Cartridge
     // The music waveform sizes
     std::array<uInt8, 3> myMusicWaveformSize{0};
 
-    // Fractional CDF music, OSC clocks unused during the last update
-    double myFractionalClocks{0.0};
+    // Music OSC, with the fractional clock unused during the last update
+    MusicClock myMusicClock;
 
     // Controls mode, lower nybble sets Fast Fetch, upper nybble sets audio
     // -0 = Fast Fetch ON
@@ -23,10 +23,9 @@
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 CartridgeCM::CartridgeCM(const ByteBuffer& image, size_t size,
                          const string& md5, const Settings& settings)
-  : Cartridge(settings, md5)
+  : Cartridge(settings, md5),
+    myImage(md5, image.get(), size, 16_KB)
 {
-  // Copy the ROM image into my buffer
-  std::copy_n(image.get(), std::min(myImage.size(), size), myImage.begin());
   createCodeAccessBase(myImage.size());
 }
 
@@ -172,7 +171,7 @@ bool CartridgeCM::patch(uInt16 address, uInt8 value)
   if((mySWCHA & 0x30) == 0x20)
     myRAM[address & 0x7FF] = value;
   else
-    myImage[myBankOffset + address] = value;
+    makeImageUnique(myImage)[myBankOffset + address] = value;
 
   return myBankChanged = true;
 }
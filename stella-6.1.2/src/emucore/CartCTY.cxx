@@ -57,7 +57,7 @@ void CartridgeCTY::reset()
   myRamAccessTimeout = 0;
 
   myAudioCycles = 0;
-  myFractionalClocks = 0.0;
+  myMusicClock.reset();
 
   // Upon reset we switch to the startup bank
   bank(startBank());
@@ -296,7 +296,7 @@ bool CartridgeCTY::save(Serializer& out) const
     out.putBool(myLDAimmediate);
     out.putInt(myRandomNumber);
     out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    out.putDouble(myMusicClock.fraction());
     out.putIntArray(myMusicCounters.data(), myMusicCounters.size());
     out.putIntArray(myMusicFrequencies.data(), myMusicFrequencies.size());
     out.putLong(myFrequencyImage - myTuneData.data()); // FIXME - storing pointer diff!
@@ -324,7 +324,7 @@ bool CartridgeCTY::load(Serializer& in)
     myLDAimmediate = in.getBool();
     myRandomNumber = in.getInt();
     myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    myMusicClock.setFraction(in.getDouble());
     in.getIntArray(myMusicCounters.data(), myMusicCounters.size());
     in.getIntArray(myMusicFrequencies.data(), myMusicFrequencies.size());
     myFrequencyImage = myTuneData.data() + in.getLong();
@@ -570,9 +570,7 @@ inline void CartridgeCTY::updateMusicModeDataFetchers()
   myAudioCycles = mySystem->cycles();
 
   // Calculate the number of CTY OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = myMusicClock.advance(cycles);
 
   // Let's update counters and flags of the music mode data fetchers
   if(wholeClocks > 0)
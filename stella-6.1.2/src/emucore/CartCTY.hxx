@@ -22,6 +22,7 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "MusicClock.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "CartCTYWidget.hxx"
 #endif
@@ -303,8 +304,8 @@ class CartridgeCTY : public Cartridge
     // System cycle count from when the last update to music data fetchers occurred
     uInt64 myAudioCycles{0};
 
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks{0.0};
+    // Music OSC, with the fractional clock unused during the last update
+    MusicClock myMusicClock;
 
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset{0};
@@ -21,10 +21,9 @@
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 CartridgeDF::CartridgeDF(const ByteBuffer& image, size_t size,
                          const string& md5, const Settings& settings)
-  : Cartridge(settings, md5)
+  : Cartridge(settings, md5),
+    myImage(md5, image.get(), size, 128_KB)
 {
-  // Copy the ROM image into my buffer
-  std::copy_n(image.get(), std::min(myImage.size(), size), myImage.begin());
   createCodeAccessBase(myImage.size());
 }
 
@@ -114,7 +113,7 @@ uInt16 CartridgeDF::bankCount() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CartridgeDF::patch(uInt16 address, uInt8 value)
 {
-  myImage[myBankOffset + (address & 0x0FFF)] = value;
+  makeImageUnique(myImage)[myBankOffset + (address & 0x0FFF)] = value;
   return myBankChanged = true;
 }
 
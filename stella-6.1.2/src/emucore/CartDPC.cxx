@@ -40,13 +40,13 @@ CartridgeDPC::CartridgeDPC(const ByteBuffer& image, size_t size,
 void CartridgeDPC::reset()
 {
   myAudioCycles = 0;
-  myFractionalClocks = 0.0;
+  myMusicClock.reset();
 
   // Upon reset we switch to the startup bank
   initializeStartBank(1);
   bank(startBank());
 
-  myDpcPitch = mySettings.getInt(AudioSettings::SETTING_DPC_PITCH);
+  myMusicClock.setFrequency(mySettings.getInt(AudioSettings::SETTING_DPC_PITCH));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -89,9 +89,7 @@ inline void CartridgeDPC::updateMusicModeDataFetchers()
   myAudioCycles = mySystem->cycles();
 
   // Calculate the number of DPC OSC clocks since the last update
-  double clocks = ((myDpcPitch * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = myMusicClock.advance(cycles);
 
   if(wholeClocks <= 0)
     return;
@@ -450,7 +448,7 @@ bool CartridgeDPC::save(Serializer& out) const
     out.putByte(myRandomNumber);
 
     out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    out.putDouble(myMusicClock.fraction());
   }
   catch(...)
   {
@@ -490,7 +488,7 @@ bool CartridgeDPC::load(Serializer& in)
 
     // Get system cycles and fractional clocks
     myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    myMusicClock.setFraction(in.getDouble());
   }
   catch(...)
   {
@@ -22,6 +22,7 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "MusicClock.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "CartDPCWidget.hxx"
 #endif
@@ -127,7 +128,7 @@ class CartridgeDPC : public Cartridge
     */
     string name() const override { return "CartridgeDPC"; }
 
-    void setDpcPitch(double pitch) { myDpcPitch = pitch; }
+    void setDpcPitch(double pitch) { myMusicClock.setFrequency(pitch); }
 
   #ifdef DEBUGGER_SUPPORT
     /**
@@ -204,15 +205,12 @@ class CartridgeDPC : public Cartridge
     // System cycle count from when the last update to music data fetchers occurred
     uInt64 myAudioCycles{0};
 
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks{0.0};
+    // Music OSC, with the fractional clock unused during the last update
+    MusicClock myMusicClock;
 
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset{0};
 
-    // DPC pitch
-    double myDpcPitch{0.0};
-
   private:
     // Following constructors and assignment operators not supported
     CartridgeDPC() = delete;
@@ -29,13 +29,11 @@
 CartridgeDPCPlus::CartridgeDPCPlus(const ByteBuffer& image, size_t size,
                                    const string& md5, const Settings& settings)
   : Cartridge(settings, md5),
-    mySize(std::min(size, myImage.size()))
+    // Image is always 32K, but in the case of ROM > 29K, the image is
+    // copied to the end of the buffer
+    myImage(md5, image.get(), size, 32_KB, 32_KB - std::min<size_t>(size, 32_KB)),
+    mySize(std::min<size_t>(size, 32_KB))
 {
-  // Image is always 32K, but in the case of ROM > 29K, the image is
-  // copied to the end of the buffer
-  if(mySize < myImage.size())
-    myImage.fill(0);
-  std::copy_n(image.get(), size, myImage.begin() + (myImage.size() - mySize));
   createCodeAccessBase(24_KB);
 
   // Pointer to the program ROM (24K @ 3K offset; ignore first 3K)
@@ -50,7 +48,7 @@ CartridgeDPCPlus::CartridgeDPCPlus(const ByteBuffer& image, size_t size,
   // Create Thumbulator ARM emulator
   bool devSettings = settings.getBool("dev.settings");
   myThumbEmulator = make_unique<Thumbulator>
-      (reinterpret_cast<uInt16*>(myImage.data()),
+      (reinterpret_cast<const uInt16*>(myImage.data()),
        reinterpret_cast<uInt16*>(myDPCRAM.data()),
        static_cast<uInt32>(myImage.size()),
        devSettings ? settings.getBool("dev.thumb.trapfatal") : false,
@@ -113,7 +111,7 @@ void CartridgeDPCPlus::setInitialState()
   // Initialize various other parameters
   myFastFetch = myLDAimmediate = false;
   myAudioCycles = myARMCycles = 0;
-  myFractionalClocks = 0.0;
+  myMusicClock.reset();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -161,9 +159,7 @@ inline void CartridgeDPCPlus::updateMusicModeDataFetchers()
   myAudioCycles = mySystem->cycles();
 
   // Calculate the number of DPC+ OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = myMusicClock.advance(cycles);
 
   // Let's update counters and flags of the music mode data fetchers
   if(wholeClocks > 0)
@@ -199,7 +195,8 @@ inline void CartridgeDPCPlus::callFunction(uInt8 value)
         Int32 cycles = Int32(mySystem->cycles() - myARMCycles);
         myARMCycles = mySystem->cycles();
 
-        myThumbEmulator->run(cycles);
+        if(myThumbEmulator->call(cycles) == Thumbulator::Status::aborted)
+          throw runtime_error("ARM code did not return");
       }
       catch(const runtime_error& e) {
         if(!mySystem->autodetectMode())
@@ -630,7 +627,14 @@ bool CartridgeDPCPlus::patch(uInt16 address, uInt8 value)
   // For now, we ignore attempts to patch the DPC address space
   if(address >= 0x0080)
   {
-    myProgramImage[myBankOffset + (address & 0x0FFF)] = value;
+    // The image may be shared with other cartridges, so patch a copy
+    uInt8* image = myImage.makeUnique();
+    if(image + 3_KB != myProgramImage)
+    {
+      myProgramImage = image + 3_KB;
+      myThumbEmulator->setRom(reinterpret_cast<const uInt16*>(image));
+    }
+    image[3_KB + myBankOffset + (address & 0x0FFF)] = value;
     return myBankChanged = true;
   }
   else
@@ -691,7 +695,7 @@ bool CartridgeDPCPlus::save(Serializer& out) const
 
     // Get system cycles and fractional clocks
     out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    out.putDouble(myMusicClock.fraction());
 
     // Clock info for Thumbulator
     out.putLong(myARMCycles);
@@ -752,7 +756,7 @@ bool CartridgeDPCPlus::load(Serializer& in)
 
     // Get audio cycles and fractional clocks
     myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    myMusicClock.setFraction(in.getDouble());
 
     // Clock info for Thumbulator
     myARMCycles = in.getLong();
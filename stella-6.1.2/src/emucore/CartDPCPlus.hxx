@@ -27,6 +27,8 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "SharedRom.hxx"
+#include "MusicClock.hxx"
 
 /**
   Cartridge class used for DPC+, derived from Pitfall II.  There are six 4K
@@ -119,6 +121,14 @@ class CartridgeDPCPlus : public Cartridge
     */
     const uInt8* getImage(size_t& size) const override;
 
+    /**
+      Not supported, since the image is shared with other consoles, and
+      the ARM driver runs from a copy in RAM.
+
+      @return  Always false
+    */
+    bool reload(const ByteBuffer&, size_t) override { return false; }
+
     /**
       Save the current state of this cart to the given Serializer.
 
@@ -200,11 +210,11 @@ class CartridgeDPCPlus : public Cartridge
 
   private:
     // The ROM image and size
-    std::array<uInt8, 32_KB> myImage;
+    SharedRom myImage;
     size_t mySize{0};
 
     // Pointer to the 24K program ROM image of the cartridge
-    uInt8* myProgramImage{nullptr};
+    const uInt8* myProgramImage{nullptr};
 
     // Pointer to the 4K display ROM image of the cartridge
     uInt8* myDisplayImage{nullptr};
@@ -266,8 +276,8 @@ class CartridgeDPCPlus : public Cartridge
     // System cycle count when the last Thumbulator::run() occurred
     uInt64 myARMCycles{0};
 
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks{0.0};
+    // Music OSC, with the fractional clock unused during the last update
+    MusicClock myMusicClock;
 
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset{0};
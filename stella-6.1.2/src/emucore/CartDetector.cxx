@@ -63,13 +63,14 @@
 #include "MD5.hxx"
 #include "Props.hxx"
 #include "Logger.hxx"
+#include "DetectionCache.hxx"
 
 #include "CartDetector.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 unique_ptr<Cartridge> CartDetector::create(const FilesystemNode& file,
     const ByteBuffer& image, size_t size, string& md5,
-    const string& propertiesType, Settings& settings)
+    const string& propertiesType, Settings& settings, DetectionCache* cache)
 {
   unique_ptr<Cartridge> cartridge;
   Bankswitch::Type type = Bankswitch::nameToType(propertiesType),
@@ -87,9 +88,27 @@ unique_ptr<Cartridge> CartDetector::create(const FilesystemNode& file,
 
   // See if we should try to auto-detect the cartridge type
   // If we ask for extended info, always do an autodetect
-  if(type == Bankswitch::Type::_AUTO || settings.getBool("rominfo"))
+  const bool rominfo = settings.getBool("rominfo");
+  if(type == Bankswitch::Type::_AUTO || rominfo)
   {
-    detectedType = autodetectType(image, size);
+    // Use the cached result, if available; this must be done using the md5
+    // of the complete image, since multicarts are split up below
+    // The cache is bypassed when the type is forced or extended info is
+    // requested, so that the forced type is checked against a real detection
+    DetectionCache::Entry entry = cache ? cache->get(md5) : DetectionCache::Entry();
+    detectedType = type == Bankswitch::Type::_AUTO && !rominfo
+      ? Bankswitch::nameToType(entry.bankswitch) : Bankswitch::Type::_AUTO;
+
+    if(detectedType == Bankswitch::Type::_AUTO)
+    {
+      detectedType = autodetectType(image, size);
+      if(cache)
+      {
+        entry.bankswitch = Bankswitch::typeToName(detectedType);
+        cache->put(md5, entry);
+      }
+    }
+
     if(type != Bankswitch::Type::_AUTO && type != detectedType)
       cerr << "Auto-detection not consistent: "
            << Bankswitch::typeToName(type) << ", "
@@ -20,6 +20,7 @@
 
 class Cartridge;
 class Properties;
+class DetectionCache;
 
 #include "Bankswitch.hxx"
 #include "bspf.hxx"
@@ -43,15 +44,20 @@ class CartDetector
       @param md5      The md5sum for the given ROM image (can be updated)
       @param dtype    The detected bankswitch type of the ROM image
       @param settings The settings container
+      @param cache    Cache for autodetection results (optional)
       @return   Pointer to the new cartridge object allocated on the heap
     */
     static unique_ptr<Cartridge> create(const FilesystemNode& file,
                  const ByteBuffer& image, size_t size, string& md5,
-                 const string& dtype, Settings& settings);
+                 const string& dtype, Settings& settings,
+                 DetectionCache* cache = nullptr);
 
     /**
       Try to auto-detect the bankswitching type of the cartridge
 
+      NOTE: Changes which alter the detection results require bumping
+            DetectionCache::DETECTION_VERSION
+
       @param image  A pointer to the ROM image
       @param size   The size of the ROM image
 
@@ -21,10 +21,9 @@
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 CartridgeE0::CartridgeE0(const ByteBuffer& image, size_t size,
                          const string& md5, const Settings& settings)
-  : Cartridge(settings, md5)
+  : Cartridge(settings, md5),
+    myImage(md5, image.get(), size, 8_KB)
 {
-  // Copy the ROM image into my buffer
-  std::copy_n(image.get(), std::min(myImage.size(), size), myImage.begin());
   createCodeAccessBase(myImage.size());
 }
 
@@ -196,7 +195,7 @@ void CartridgeE0::segmentTwo(uInt16 slice)
 bool CartridgeE0::patch(uInt16 address, uInt8 value)
 {
   address &= 0x0FFF;
-  myImage[(myCurrentSlice[address >> 10] << 10) + (address & 0x03FF)] = value;
+  makeImageUnique(myImage)[(myCurrentSlice[address >> 10] << 10) + (address & 0x03FF)] = value;
   return true;
 }
 
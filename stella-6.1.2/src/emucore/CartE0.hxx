@@ -22,6 +22,7 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "SharedRom.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "CartE0Widget.hxx"
 #endif
@@ -102,6 +103,18 @@ class CartridgeE0 : public Cartridge
     */
     const uInt8* getImage(size_t& size) const override;
 
+    /**
+      Replace the ROM image, see Cartridge::reload().  The image may be
+      shared with other consoles, so this cart gets a copy of its own.
+
+      @param image  The new ROM image
+      @param size   The size of the new ROM image
+      @return  False if the image can't be replaced this way
+    */
+    bool reload(const ByteBuffer& image, size_t size) override {
+      return reloadImage(myImage, image, size);
+    }
+
     /**
       Save the current state of this cart to the given Serializer.
 
@@ -178,7 +191,7 @@ class CartridgeE0 : public Cartridge
 
   private:
     // The 8K ROM image of the cartridge
-    std::array<uInt8, 8_KB> myImage;
+    SharedRom myImage;
 
     // Indicates the slice mapped into each of the four segments
     std::array<uInt16, 4> myCurrentSlice;
@@ -22,6 +22,7 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "SharedRom.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "CartF0Widget.hxx"
 #endif
@@ -100,6 +101,18 @@ class CartridgeF0 : public Cartridge
     */
     const uInt8* getImage(size_t& size) const override;
 
+    /**
+      Replace the ROM image, see Cartridge::reload().  The image may be
+      shared with other consoles, so this cart gets a copy of its own.
+
+      @param image  The new ROM image
+      @param size   The size of the new ROM image
+      @return  False if the image can't be replaced this way
+    */
+    bool reload(const ByteBuffer& image, size_t size) override {
+      return reloadImage(myImage, image, size);
+    }
+
     /**
       Save the current state of this cart to the given Serializer.
 
@@ -160,7 +173,7 @@ class CartridgeF0 : public Cartridge
 
   private:
     // The 64K ROM image of the cartridge
-    std::array<uInt8, 64_KB> myImage;
+    SharedRom myImage;
 
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset{0};
@@ -28,6 +28,7 @@
 #include "Event.hxx"
 #include "EventHandler.hxx"
 #include "ControllerDetector.hxx"
+#include "DetectionCache.hxx"
 #include "Joystick.hxx"
 #include "Keyboard.hxx"
 #include "KidVid.hxx"
@@ -54,12 +55,12 @@
 #include "OSystem.hxx"
 #include "Serializable.hxx"
 #include "Serializer.hxx"
-#include "TimerManager.hxx"
 #include "Version.hxx"
 #include "TIAConstants.hxx"
 #include "FrameLayout.hxx"
 #include "AudioQueue.hxx"
 #include "AudioSettings.hxx"
+#include "AVCapture.hxx"
 #include "frame-manager/FrameManager.hxx"
 #include "frame-manager/FrameLayoutDetector.hxx"
 
@@ -94,7 +95,7 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
   myTIA->setFrameManager(myFrameManager.get());
 
   // Reinitialize the RNG
-  myOSystem.random().initSeed(static_cast<uInt32>(TimerManager::getTicks()));
+  myOSystem.random().initSeed(myOSystem.randomSeed());
 
   // Construct the system and components
   mySystem = make_unique<System>(myOSystem.random(), *my6502, *myRiot, *myTIA, *myCart);
@@ -132,9 +133,22 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
   myOSystem.sound().mute(1);
   myOSystem.frameBuffer().clear();
 
-  if(myDisplayFormat == "AUTO" || myOSystem.settings().getBool("rominfo"))
+  const bool rominfo = myOSystem.settings().getBool("rominfo");
+  if(myDisplayFormat == "AUTO" || rominfo)
   {
-    autodetectFrameLayout();
+    // Detecting the frame layout requires emulating quite a few frames,
+    // so we reuse earlier results whenever possible (but not when the
+    // format is forced, or extended info is requested)
+    DetectionCache::Entry entry = myOSystem.detectionCache().get(md5);
+    if(myDisplayFormat == "AUTO" && !rominfo &&
+       (entry.frameLayout == "NTSC" || entry.frameLayout == "PAL"))
+      myDisplayFormat = entry.frameLayout;
+    else
+    {
+      autodetectFrameLayout();
+      entry.frameLayout = myDisplayFormat;
+      myOSystem.detectionCache().put(md5, entry);
+    }
 
     if(myProperties.get(PropType::Display_Format) == "AUTO")
     {
@@ -181,7 +195,10 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
   bool joyallow4 = myOSystem.settings().getBool("joyallow4");
   myOSystem.eventHandler().allowAllDirections(joyallow4);
 
-  // Reset the system to its power-on state
+  // Reset the system to its power-on state; the RNG is reinitialized
+  // first, since autodetection (which may have been skipped because its
+  // results were cached) uses it too
+  myOSystem.random().initSeed(myOSystem.randomSeed());
   mySystem->reset();
   myRiot->update();
 
@@ -203,6 +220,8 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Console::~Console()
 {
+  stopCapture();
+
   // Some smart controllers need to be informed that the console is going away
   myLeftControl->close();
   myRightControl->close();
@@ -548,6 +567,17 @@ void Console::setPalette(const string& type)
     myTIA->enableFixedColors(true);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const PaletteArray& Console::standardPalette(ConsoleTiming timing)
+{
+  switch(timing)
+  {
+    case ConsoleTiming::pal:    return ourPALPalette;
+    case ConsoleTiming::secam:  return ourSECAMPalette;
+    default:                    return ourNTSCPalette;
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Console::toggleInter()
 {
@@ -663,6 +693,61 @@ void Console::initializeAudio()
   myTIA->setAudioQueue(myAudioQueue);
 
   myOSystem.sound().open(myAudioQueue, &myEmulationTiming);
+
+  if(myTurbo)
+    updateTurboAudio();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Console::startCapture(const string& basename, const string& format)
+{
+  stopCapture();
+
+  // Capture at the rates of the emulated console, independent of 'speed'
+  const EmulationTiming timing(myTIA->frameLayout(), myConsoleTiming);
+
+  myCapture = make_unique<AVCapture>();
+  if(!myCapture->start(basename, AVCapture::toVideoFormat(format),
+                       myTIA->width(), myTIA->height(),
+                       double(timing.cyclesPerSecond()) / timing.cyclesPerFrame(),
+                       myOSystem.frameBuffer().tiaSurface().rgbPalette(),
+                       timing.audioSampleRate(), myAudioQueue && myAudioQueue->isStereo()))
+  {
+    myCapture.reset();
+    return false;
+  }
+
+  myTIA->setFrameCallback([this](const uInt8* frameBuffer) {
+    myCapture->addFrame(frameBuffer);
+  });
+  if(myAudioQueue)
+    myAudioQueue->setFragmentTap([this](const Int16* fragment, uInt32 size) {
+      myCapture->addAudio(fragment, size);
+    });
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::stopCapture()
+{
+  if(!myCapture)
+    return;
+
+  myTIA->setFrameCallback(nullptr);
+  if(myAudioQueue)
+    myAudioQueue->setFragmentTap(nullptr);
+
+  const bool ok = myCapture->stop();
+
+  ostringstream buf;
+  buf << (ok ? "Capture finished: " : "ERROR: Capture incomplete: ")
+      << myCapture->frames() << " frames, "
+      << myCapture->audioSamples() << " audio samples";
+  if(ok)  Logger::info(buf.str());
+  else    Logger::error(buf.str());
+
+  myCapture.reset();
 }
 
 /* Original frying research and code by Fred Quimby.
@@ -817,11 +902,20 @@ void Console::createAudioQueue()
   bool useStereo = myOSystem.settings().getBool(AudioSettings::SETTING_STEREO)
     || myProperties.get(PropType::Cart_Sound) == "STEREO";
 
+  // Don't change the audio format in the middle of a capture
+  if(myCapture)
+    useStereo = myCapture->isStereo();
+
   myAudioQueue = make_shared<AudioQueue>(
     myEmulationTiming.audioFragmentSize(),
     myEmulationTiming.audioQueueCapacity(),
     useStereo
   );
+
+  if(myCapture)
+    myAudioQueue->setFragmentTap([this](const Int16* fragment, uInt32 size) {
+      myCapture->addAudio(fragment, size);
+    });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -854,14 +948,39 @@ void Console::setControllers(const string& romMd5)
     const uInt8* image = myCart->getImage(size);
     const bool swappedPorts = myProperties.get(PropType::Console_SwapPorts) == "YES";
 
-    // Try to detect controllers
+    // Try to detect controllers, using earlier results whenever possible
+    // (but not when extended info is requested)
     if(image != nullptr && size != 0)
     {
+      DetectionCache::Entry entry = myOSystem.detectionCache().get(romMd5);
+      const bool rominfo = myOSystem.settings().getBool("rominfo");
+
+      auto detectPort = [&](Controller::Type type, Controller::Jack port, string& cached)
+      {
+        if(type == Controller::Type::Unknown && !rominfo)
+        {
+          const Controller::Type cachedType = Controller::getType(cached);
+          if(cachedType != Controller::Type::Unknown)
+            return cachedType;
+        }
+
+        const Controller::Type detectedType =
+          ControllerDetector::detectType(image, size, type, port, myOSystem.settings());
+        if(type == Controller::Type::Unknown)
+          cached = Controller::getPropName(detectedType);
+
+        return detectedType;
+      };
+
       Logger::debug(myProperties.get(PropType::Cart_Name) + ":");
-      leftType = ControllerDetector::detectType(image, size, leftType,
-          !swappedPorts ? Controller::Jack::Left : Controller::Jack::Right, myOSystem.settings());
-      rightType = ControllerDetector::detectType(image, size, rightType,
-          !swappedPorts ? Controller::Jack::Right : Controller::Jack::Left, myOSystem.settings());
+      leftType = detectPort(leftType,
+          !swappedPorts ? Controller::Jack::Left : Controller::Jack::Right,
+          !swappedPorts ? entry.leftController : entry.rightController);
+      rightType = detectPort(rightType,
+          !swappedPorts ? Controller::Jack::Right : Controller::Jack::Left,
+          !swappedPorts ? entry.rightController : entry.leftController);
+
+      myOSystem.detectionCache().put(romMd5, entry);
     }
 
     unique_ptr<Controller> leftC = getControllerPort(leftType, Controller::Jack::Left, romMd5),
@@ -1124,6 +1243,32 @@ void Console::toggleJitter() const
   myOSystem.frameBuffer().showMessage(message);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::toggleTurbo()
+{
+  myTurbo = !myTurbo;
+  updateTurboAudio();
+
+  string message = string("Turbo mode") + (myTurbo ? " enabled" : " disabled");
+  myOSystem.frameBuffer().showMessage(message);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::updateTurboAudio()
+{
+  // The audio driver can't keep up with unthrottled emulation, so the
+  // queue is left to overflow silently while the device is muted
+  const bool enabled = myAudioSettings.enabled();
+
+  if(myTurbo)
+    myOSystem.sound().mute(true);
+  else if(enabled)
+    myOSystem.sound().mute(false);
+
+  if(myAudioQueue)
+    myAudioQueue->ignoreOverflows(myTurbo || !enabled);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Console::attachDebugger(Debugger& dbg)
 {
@@ -29,6 +29,7 @@ class CompuMate;
 class Debugger;
 class AudioQueue;
 class AudioSettings;
+class AVCapture;
 
 #include "bspf.hxx"
 #include "ConsoleIO.hxx"
@@ -257,6 +258,33 @@ class Console : public Serializable, public ConsoleIO
     */
     void initializeAudio();
 
+    /**
+      Start capturing the emulated video and audio output into files
+      starting with the given name (see AVCapture for details).
+
+      @param basename  The path and name of the files, without extension
+      @param format    The format of the video file ('y4m' or 'raw')
+
+      @return  False if the capture couldn't be started, else true
+    */
+    bool startCapture(const string& basename, const string& format);
+
+    /**
+      Stop capturing, and wait until all data has been written.
+    */
+    void stopCapture();
+
+    /**
+      Toggles turbo mode.  In turbo mode, emulation runs as fast as possible,
+      only some of the frames are rendered and audio is muted.
+    */
+    void toggleTurbo();
+
+    /**
+      Answers whether turbo mode is currently enabled.
+    */
+    bool turbo() const { return myTurbo; }
+
     /**
       "Fry" the Atari (mangle memory/TIA contents)
     */
@@ -326,6 +354,11 @@ class Console : public Serializable, public ConsoleIO
     */
     void setTIAProperties();
 
+    /**
+      Returns the standard palette for the given console timing.
+    */
+    static const PaletteArray& standardPalette(ConsoleTiming timing);
+
   private:
     /**
      * Define console timing based on current display format
@@ -375,6 +408,11 @@ class Console : public Serializable, public ConsoleIO
     void toggleTIABit(TIABit bit, const string& bitname, bool show = true) const;
     void toggleTIACollision(TIABit bit, const string& bitname, bool show = true) const;
 
+    /**
+      Mutes the audio output while in turbo mode, and restores it afterwards.
+    */
+    void updateTurboAudio();
+
   private:
     // Reference to the osystem object
     OSystem& myOSystem;
@@ -404,6 +442,12 @@ class Console : public Serializable, public ConsoleIO
     // The audio fragment queue that connects TIA and audio driver
     shared_ptr<AudioQueue> myAudioQueue;
 
+    // Records video and audio (only while capturing)
+    unique_ptr<AVCapture> myCapture;
+
+    // Emulation runs unthrottled (see OSystem::dispatchEmulation)
+    bool myTurbo{false};
+
     // Pointer to the Cartridge (the debugger needs it)
     unique_ptr<Cartridge> myCart;
 
@@ -38,6 +38,9 @@ class ControllerDetector
       @param port       The port to be checked
       @param settings   A reference to the various settings (read-only)
       @return   The detected controller type
+
+      NOTE: Changes which alter the detection results require bumping
+            DetectionCache::DETECTION_VERSION
     */
     static Controller::Type detectType(const uInt8* image, size_t size,
         const Controller::Type controller, const Controller::Jack port,
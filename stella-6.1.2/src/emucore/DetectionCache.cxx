@@ -0,0 +1,107 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "DetectionCache.hxx"
+
+namespace {
+  constexpr char SEPARATOR = ',';
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+DetectionCache::DetectionCache(shared_ptr<KeyValueRepository> repository)
+  : myRepository(std::move(repository))
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+DetectionCache::Entry DetectionCache::get(const string& md5)
+{
+  load();
+
+  auto it = myEntries.find(md5);
+  return it != myEntries.end() ? it->second : Entry();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DetectionCache::put(const string& md5, const Entry& entry)
+{
+  if(md5 == EmptyString)
+    return;
+
+  load();
+
+  const string& value = encode(entry);
+  auto it = myEntries.find(md5);
+  if(it != myEntries.end() && encode(it->second) == value)
+    return;
+
+  myEntries[md5] = entry;
+  myRepository->save(md5, value);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DetectionCache::load()
+{
+  if(myIsLoaded)
+    return;
+
+  for(const auto& pair: myRepository->load())
+  {
+    Entry entry;
+
+    // Entries from other versions of the detection code are simply ignored,
+    // they will be overwritten the next time the ROM is detected
+    if(decode(pair.second.toString(), entry))
+      myEntries[pair.first] = entry;
+  }
+  myIsLoaded = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string DetectionCache::encode(const Entry& entry)
+{
+  ostringstream buf;
+
+  buf << DETECTION_VERSION << SEPARATOR
+      << entry.bankswitch << SEPARATOR
+      << entry.frameLayout << SEPARATOR
+      << entry.leftController << SEPARATOR
+      << entry.rightController;
+
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DetectionCache::decode(const string& value, Entry& entry)
+{
+  std::array<string, 5> fields;
+  istringstream buf(value);
+
+  for(auto& field: fields)
+    if(!std::getline(buf, field, SEPARATOR) && &field != &fields.back())
+      return false;
+
+  if(BSPF::stringToInt(fields[0], -1) != int(DETECTION_VERSION))
+    return false;
+
+  entry.bankswitch      = fields[1];
+  entry.frameLayout     = fields[2];
+  entry.leftController  = fields[3];
+  entry.rightController = fields[4];
+
+  return true;
+}
@@ -0,0 +1,97 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef DETECTION_CACHE_HXX
+#define DETECTION_CACHE_HXX
+
+#include <map>
+
+#include "bspf.hxx"
+#include "repository/KeyValueRepository.hxx"
+
+/**
+  This class caches the results of the various (expensive) ROM detection
+  steps, keyed by the MD5 of the ROM image.  This includes the bankswitch
+  type, the frame layout (which involves emulating several frames) and the
+  controller types.
+
+  Results are persisted through a KeyValueRepository, so they survive
+  restarts of the application.  Each entry is tagged with the version of the
+  detection code; whenever one of the detectors changes in a way that may
+  alter its results, DETECTION_VERSION must be bumped, which invalidates all
+  existing entries.
+*/
+class DetectionCache
+{
+  public:
+    static constexpr uInt32 DETECTION_VERSION = 1;
+
+    /**
+      The detected properties of a ROM; empty fields have not been
+      detected (yet).
+    */
+    struct Entry {
+      string bankswitch;
+      string frameLayout;
+      string leftController;
+      string rightController;
+    };
+
+  public:
+    explicit DetectionCache(shared_ptr<KeyValueRepository> repository);
+
+    /**
+      Get the cached detection results for the given ROM.
+
+      @param md5  The md5sum of the ROM image
+      @return  The cached entry; fields which aren't cached are empty
+    */
+    Entry get(const string& md5);
+
+    /**
+      Store the detection results for the given ROM; the entry is persisted
+      immediately, but only if it actually changed.
+
+      @param md5    The md5sum of the ROM image
+      @param entry  The detection results
+    */
+    void put(const string& md5, const Entry& entry);
+
+  private:
+    // Convert entries to and from their persisted form
+    static string encode(const Entry& entry);
+    static bool decode(const string& value, Entry& entry);
+
+    // Load the persisted entries on first use
+    void load();
+
+  private:
+    shared_ptr<KeyValueRepository> myRepository;
+
+    std::map<string, Entry> myEntries;
+    bool myIsLoaded{false};
+
+  private:
+    // Following constructors and assignment operators not supported
+    DetectionCache() = delete;
+    DetectionCache(const DetectionCache&) = delete;
+    DetectionCache(DetectionCache&&) = delete;
+    DetectionCache& operator=(const DetectionCache&) = delete;
+    DetectionCache& operator=(DetectionCache&&) = delete;
+};
+
+#endif // DETECTION_CACHE_HXX
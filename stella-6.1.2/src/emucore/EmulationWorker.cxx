@@ -69,7 +69,8 @@ void EmulationWorker::handlePossibleException()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void EmulationWorker::start(uInt32 cyclesPerSecond, uInt64 maxCycles, uInt64 minCycles, DispatchResult* dispatchResult, TIA* tia)
+void EmulationWorker::start(uInt32 cyclesPerSecond, uInt64 maxCycles, uInt64 minCycles, DispatchResult* dispatchResult, TIA* tia,
+                            bool throttle)
 {
   // Wait until any pending signal has been processed
   waitUntilPendingSignalHasProcessed();
@@ -96,6 +97,7 @@ void EmulationWorker::start(uInt32 cyclesPerSecond, uInt64 maxCycles, uInt64 min
     myCyclesPerSecond = cyclesPerSecond;
     myMaxCycles = maxCycles;
     myMinCycles = minCycles;
+    myThrottle = throttle;
     myDispatchResult = dispatchResult;
 
     // Raise the signal...
@@ -273,7 +275,8 @@ void EmulationWorker::dispatchEmulation(std::unique_lock<std::mutex>& lock)
 
   bool continueEmulating = false;
 
-  if (myDispatchResult->getStatus() == DispatchResult::Status::ok) {
+  // Without throttling, we run a single timeslice and then wait for the main thread to stop us
+  if (myThrottle && myDispatchResult->getStatus() == DispatchResult::Status::ok) {
     // If emulation finished successfully, we are free to go for another round
     duration<double> timesliceSeconds(static_cast<double>(totalCycles) / static_cast<double>(myCyclesPerSecond));
     myVirtualTime += duration_cast<high_resolution_clock::duration>(timesliceSeconds);
@@ -66,8 +66,11 @@ class EmulationWorker
 
     /**
       Wake up the worker and start emulation with the specified parameters.
+      If throttle is false, the worker does not sync to real time; it emulates a
+      single timeslice and then waits to be stopped.
      */
-    void start(uInt32 cyclesPerSecond, uInt64 maxCycles, uInt64 minCycles, DispatchResult* dispatchResult, TIA* tia);
+    void start(uInt32 cyclesPerSecond, uInt64 maxCycles, uInt64 minCycles, DispatchResult* dispatchResult, TIA* tia,
+               bool throttle = true);
 
     /**
       Stop emulation and return the number of 6507 cycles emulated.
@@ -192,6 +195,7 @@ class EmulationWorker
     uInt64 myCyclesPerSecond{0};
     uInt64 myMaxCycles{0};
     uInt64 myMinCycles{0};
+    bool myThrottle{true};
     DispatchResult* myDispatchResult{nullptr};
 
     // Total number of cycles during this emulation run
@@ -549,6 +549,10 @@ void EventHandler::handleEvent(Event::Type event, Int32 value, bool repeated)
       if (pressed && !repeated) myOSystem.state().toggleTimeMachine();
       return;
 
+    case Event::ToggleTurbo:
+      if (pressed && !repeated) myOSystem.console().toggleTurbo();
+      return;
+
   #ifdef PNG_SUPPORT
     case Event::ToggleContSnapshots:
       if (pressed && !repeated) myOSystem.png().toggleContinuousSnapshots(false);
@@ -1812,6 +1816,7 @@ EventHandler::EmulActionList EventHandler::ourEmulActionList = { {
   { Event::CmdMenuMode,             "Toggle Commands menu UI",               "" },
   { Event::TogglePauseMode,         "Toggle Pause mode",                     "" },
   { Event::StartPauseMode,          "Start Pause mode",                      "" },
+  { Event::ToggleTurbo,             "Toggle Turbo mode",                     "" },
   { Event::Fry,                     "Fry cartridge",                         "" },
   { Event::DebuggerMode,            "Toggle Debugger mode",                  "" },
 
@@ -2020,7 +2025,8 @@ EventHandler::MenuActionList EventHandler::ourMenuActionList = { {
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const Event::EventSet EventHandler::MiscEvents = {
   Event::Quit, Event::ReloadConsole, Event::Fry, Event::StartPauseMode,
-  Event::TogglePauseMode, Event::OptionsMenuMode, Event::CmdMenuMode, Event::ExitMode,
+  Event::TogglePauseMode, Event::ToggleTurbo,
+  Event::OptionsMenuMode, Event::CmdMenuMode, Event::ExitMode,
   Event::TakeSnapshot, Event::ToggleContSnapshots, Event::ToggleContSnapshotsFrame,
   // Event::MouseAxisXMove, Event::MouseAxisYMove,
   // Event::MouseButtonLeftValue, Event::MouseButtonRightValue,
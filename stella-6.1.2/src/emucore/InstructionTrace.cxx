@@ -0,0 +1,142 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "InstructionTrace.hxx"
+
+namespace {
+  // "STLTRC" followed by the format version and the entry size
+  constexpr std::array<uInt8, InstructionTrace::HEADER_SIZE> HEADER = {
+    'S', 'T', 'L', 'T', 'R', 'C', 1, InstructionTrace::ENTRY_SIZE
+  };
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+InstructionTrace::InstructionTrace(uInt32 sizeBits)
+  : myBuffer(size_t(1) << sizeBits),
+    myMask((uInt64(1) << sizeBits) - 1),
+    myHalfMask(myMask >> 1)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void InstructionTrace::setStream(ostream* out)
+{
+  myStream = out;
+  myStreamed = myCount;
+
+  if(myStream)
+    writeHeader(*myStream);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void InstructionTrace::flush()
+{
+  if(myStream)
+  {
+    writeEntries();
+    myStream->flush();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void InstructionTrace::writeEntries()
+{
+  // Entries which were overwritten before they could be streamed are lost
+  uInt64 i = std::max(myStreamed, myCount > myMask ? myCount - myMask - 1 : 0);
+  std::array<uInt8, ENTRY_SIZE> data;
+
+  for(; i < myCount; ++i)
+  {
+    encode(myBuffer[i & myMask], data.data());
+    myStream->write(reinterpret_cast<const char*>(data.data()), ENTRY_SIZE);
+  }
+  myStreamed = myCount;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void InstructionTrace::writeHeader(ostream& out)
+{
+  out.write(reinterpret_cast<const char*>(HEADER.data()), HEADER_SIZE);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool InstructionTrace::readHeader(istream& in)
+{
+  std::array<uInt8, HEADER_SIZE> header;
+
+  return in.read(reinterpret_cast<char*>(header.data()), HEADER_SIZE) &&
+         header == HEADER;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void InstructionTrace::encode(const Entry& entry, uInt8* data)
+{
+  const auto put16 = [&data](uInt16 v) {
+    *data++ = v & 0xff;  *data++ = v >> 8;
+  };
+
+  for(int i = 0; i < 32; i += 8)
+    *data++ = (entry.cycle >> i) & 0xff;
+  put16(entry.pc);
+  put16(entry.bank);
+  put16(entry.peekAddress);
+  put16(entry.pokeAddress);
+  put16(entry.scanline);
+  *data++ = entry.clock;
+  *data++ = entry.opcode;
+  *data++ = entry.operand[0];
+  *data++ = entry.operand[1];
+  *data++ = entry.a;
+  *data++ = entry.x;
+  *data++ = entry.y;
+  *data++ = entry.sp;
+  *data++ = entry.ps;
+  *data   = 0;  // reserved
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool InstructionTrace::read(istream& in, Entry& entry)
+{
+  std::array<uInt8, ENTRY_SIZE> buf;
+  if(!in.read(reinterpret_cast<char*>(buf.data()), ENTRY_SIZE))
+    return false;
+
+  const uInt8* data = buf.data();
+  const auto get16 = [&data]() {
+    uInt16 v = data[0] | (data[1] << 8);  data += 2;
+    return v;
+  };
+
+  entry.cycle = data[0] | (data[1] << 8) | (data[2] << 16) | (uInt32(data[3]) << 24);
+  data += 4;
+  entry.pc = get16();
+  entry.bank = get16();
+  entry.peekAddress = get16();
+  entry.pokeAddress = get16();
+  entry.scanline = get16();
+  entry.clock = *data++;
+  entry.opcode = *data++;
+  entry.operand[0] = *data++;
+  entry.operand[1] = *data++;
+  entry.a = *data++;
+  entry.x = *data++;
+  entry.y = *data++;
+  entry.sp = *data++;
+  entry.ps = *data;
+
+  return true;
+}
@@ -0,0 +1,117 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef INSTRUCTION_TRACE_HXX
+#define INSTRUCTION_TRACE_HXX
+
+#include "bspf.hxx"
+
+/**
+  A fixed-size ring buffer of the instructions executed by the CPU.
+
+  The buffer is only ever written by the emulation thread, and needs no
+  locking.  When a stream is attached, each completed half of the buffer
+  is appended to it, so a trace can cover any number of instructions.
+
+  In the stream, each entry is stored as ENTRY_SIZE bytes in little-endian
+  order (in the order of the Entry fields), after a header of HEADER_SIZE
+  bytes.
+*/
+class InstructionTrace
+{
+  public:
+    struct Entry {
+      uInt32 cycle{0};          // lower 32 bits of the system cycle at the end
+      uInt16 pc{0};             // address of the opcode
+      uInt16 bank{0};           // bank of 'pc' when the opcode was fetched
+      uInt16 peekAddress{0};    // last address read by the instruction
+      uInt16 pokeAddress{0};    // last address written (0 if none)
+      uInt16 scanline{0};       // TIA scanline at the end of the instruction
+      uInt8  clock{0};          // TIA color clock within the scanline
+      uInt8  opcode{0};
+      uInt8  operand[2]{0, 0};  // the bytes following the opcode
+      uInt8  a{0}, x{0}, y{0}, sp{0}, ps{0};  // registers after the instruction
+    };
+    static constexpr uInt32 ENTRY_SIZE = 24;
+    static constexpr uInt32 HEADER_SIZE = 8;
+
+    /**
+      Create a trace buffer for 2^sizeBits entries.
+    */
+    explicit InstructionTrace(uInt32 sizeBits = 16);
+
+    /**
+      Record an instruction, and stream out a completed half of the buffer.
+    */
+    void add(const Entry& entry) {
+      myBuffer[myCount & myMask] = entry;
+      if((++myCount & myHalfMask) == 0 && myStream)
+        writeEntries();
+    }
+
+    /**
+      Attach a stream which receives all following entries (nullptr
+      detaches it).  The header is written immediately.
+    */
+    void setStream(ostream* out);
+
+    /**
+      Write the entries not streamed yet to the attached stream.
+    */
+    void flush();
+
+    /**
+      The number of instructions recorded so far.
+    */
+    uInt64 count() const { return myCount; }
+
+    /**
+      Read and check the header of a trace stream.
+    */
+    static bool readHeader(istream& in);
+
+    /**
+      Read the next entry from a trace stream.
+
+      @return  False at the end of the stream
+    */
+    static bool read(istream& in, Entry& entry);
+
+  private:
+    // Write the entries not streamed yet to the attached stream
+    void writeEntries();
+
+    static void writeHeader(ostream& out);
+    static void encode(const Entry& entry, uInt8* data);
+
+  private:
+    vector<Entry> myBuffer;
+    uInt64 myMask{0}, myHalfMask{0};
+    uInt64 myCount{0};
+
+    ostream* myStream{nullptr};
+    uInt64 myStreamed{0};  // number of entries written to the stream
+
+  private:
+    // Following constructors and assignment operators not supported
+    InstructionTrace(const InstructionTrace&) = delete;
+    InstructionTrace(InstructionTrace&&) = delete;
+    InstructionTrace& operator=(const InstructionTrace&) = delete;
+    InstructionTrace& operator=(InstructionTrace&&) = delete;
+};
+
+#endif
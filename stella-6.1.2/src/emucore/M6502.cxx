@@ -101,6 +101,11 @@ void M6502::reset()
   myWriteToReadPortBreak = devSettings ? mySettings.getBool("dev.wrportbreak") : false;
 
   myLastBreakCycle = ULLONG_MAX;
+
+  myIdleSkip = mySettings.getBool("idleskip");
+  myIdleLoopPC = myIdleLoopAddress = 0;
+  myIdleLoopCycle = 0;
+  myIdleCyclesSkipped = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -122,9 +127,20 @@ inline uInt8 M6502::peek(uInt16 address, uInt8 flags)
   uInt8 result = mySystem->peek(address, flags);
   myLastPeekAddress = address;
 
+  // Remember the operands of a traced instruction as they are fetched,
+  // from the bank and memory contents the instruction really used
+  if(myTrace)
+  {
+    const uInt16 offset = address - myTracePC - 1;
+    if(offset < 2 && !(myTraceOperandMask & (1 << offset)))
+    {
+      myTraceOperands[offset] = result;
+      myTraceOperandMask |= 1 << offset;
+    }
+  }
+
 #ifdef DEBUGGER_SUPPORT
-  if(myReadTraps.isInitialized() && myReadTraps.isSet(address)
-     && (myGhostReadsTrap || flags != DISASM_NONE))
+  if(myReadTraps.isSet(address) && (myGhostReadsTrap || flags != DISASM_NONE))
   {
     myLastPeekBaseAddress = myDebugger->getBaseAddress(myLastPeekAddress, true); // mirror handling
     int cond = evalCondTraps();
@@ -160,7 +176,7 @@ inline void M6502::poke(uInt16 address, uInt8 value, uInt8 flags)
   myLastPokeAddress = address;
 
 #ifdef DEBUGGER_SUPPORT
-  if(myWriteTraps.isInitialized() && myWriteTraps.isSet(address))
+  if(myWriteTraps.isSet(address))
   {
     myLastPokeBaseAddress = myDebugger->getBaseAddress(myLastPokeAddress, false); // mirror handling
     int cond = evalCondTraps();
@@ -192,6 +208,15 @@ inline void M6502::handleHalt()
   }
 }
 
+#ifdef DEBUGGER_SUPPORT
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline bool M6502::runToReached() const
+{
+  return (myRunToPCs && myRunToPCs->check(PC, mySystem->cart().getBank(PC))) ||
+         (myRunWhileCond && !myRunWhileCond->evaluate());
+}
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::execute(uInt64 number, DispatchResult& result)
 {
@@ -287,6 +312,14 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
           result.setDebugger(currentCycles, msg.str());
           return;
         }
+
+        if(myRunToActive && runToReached())
+        {
+          myLastBreakCycle = mySystem->cycles();
+          myRunToActive = false;
+          myRunToHit = true;
+          return;
+        }
       }
 
       int cond = evalCondSaveStates();
@@ -308,8 +341,17 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
         uInt8 operand = 0;
 
         icycles = 0;
-    #ifdef DEBUGGER_SUPPORT
         uInt16 oldPC = PC;
+        uInt16 traceBank = 0;
+        if(myTrace)
+        {
+          traceBank = mySystem->cart().getBank(PC);
+          myTracePC = PC;
+          myTraceOperandMask = 0;
+        }
+    #ifdef DEBUGGER_SUPPORT
+        uInt16 profileBank = myProfiler ? mySystem->cart().getBank(PC) : 0;
+        uInt64 profileCycle = mySystem->cycles();
     #endif
 
         // Fetch instruction at the program counter
@@ -325,6 +367,17 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
             FatalEmulationError::raise("invalid instruction");
         }
 
+    #ifdef DEBUGGER_SUPPORT
+        if(myProfiler)
+          profileInstruction(oldPC, profileBank, profileCycle);
+    #endif
+
+        if(myTrace)
+          traceInstruction(oldPC, traceBank);
+
+        if(myIdleSkip)
+          checkIdleLoop(intermediateAddress, previousCycles + cycles * SYSTEM_CYCLES_PER_CPU);
+
     #ifdef DEBUGGER_SUPPORT
         if(myReadFromWritePortBreak)
         {
@@ -404,6 +457,113 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline void M6502::checkIdleLoop(uInt16 address, uInt64 endCycle)
+{
+  switch(IR)
+  {
+    case 0xad:  // LDA abs
+    case 0xae:  // LDX abs
+    case 0xac:  // LDY abs
+      // INTIM and its mirrors (A12 = 0, A9 = 1, A7 = 1, A2 = 1, A0 = 0)
+      if((address & 0x1285) == 0x0284)
+      {
+        myIdleLoopPC = PC - 3;
+        myIdleLoopAddress = address;
+        myIdleLoopCycle = mySystem->cycles();
+      }
+      break;
+
+    case 0xd0:  // BNE
+      // Taken back to the load, which must have been the previous instruction
+      if(PC == myIdleLoopPC && mySystem->cycles() - icycles == myIdleLoopCycle)
+        skipIdleLoop(endCycle);
+      break;
+
+    default:
+      break;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502::skipIdleLoop(uInt64 endCycle)
+{
+  // A trace must contain every instruction
+  if(myTrace)
+    return;
+
+#ifdef DEBUGGER_SUPPORT
+  // The debugger must see every instruction
+  if(myBreakPoints.isInitialized() || !myReadTraps.isEmpty() ||
+     !myWriteTraps.isEmpty() || !myCondBreaks.empty() ||
+     !myCondSaveStates.empty() || myStepStateByInstruction || myRunToActive ||
+     myProfiler)
+    return;
+#endif
+
+  M6532& riot = mySystem->m6532();
+
+  // Cartridges may map their own devices over the RIOT
+  if(mySystem->getPageAccess(myIdleLoopAddress).device != &riot)
+    return;
+
+  const uInt64 zeroCycle = riot.timerZeroCycle();
+  const uInt64 now = mySystem->cycles();
+  // One iteration of the loop: the load (4 cycles) and the branch
+  const uInt64 period = now - myIdleLoopCycle + 4;
+  // INTIM is read on the last cycle of the load
+  const uInt64 nextRead = now + 4;
+
+  if(zeroCycle <= nextRead || now >= endCycle)
+    return;
+
+  // Skip all iterations which would read a non-zero value (the loop would
+  // continue), but don't leave the current timeslice. As nothing but the
+  // time changes (except for the access counter used by the Supercharger),
+  // the remaining iterations then run as usual.
+  const uInt64 iterations = std::min((zeroCycle - nextRead + period - 1) / period,
+                                     (endCycle - now) / period);
+  const uInt32 skipped = uInt32(iterations * period);
+
+  if(skipped == 0)
+    return;
+
+  // Each cycle of the loop accesses a different address than the one before
+  myNumberOfDistinctAccesses += skipped;
+  mySystem->incrementCycles(skipped);
+  myIdleCyclesSkipped += skipped;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502::traceInstruction(uInt16 pc, uInt16 bank)
+{
+  TIA& tia = mySystem->tia();
+  tia.updateEmulation();
+
+  InstructionTrace::Entry entry;
+  entry.cycle = uInt32(mySystem->cycles());
+  entry.pc = pc;
+  entry.bank = bank;
+  entry.peekAddress = myLastPeekAddress;
+  entry.pokeAddress = myLastPokeAddress;
+  entry.scanline = uInt16(tia.scanlines());
+  entry.clock = uInt8(tia.clocksThisLine());
+  entry.opcode = IR;
+
+  // Only the operands the instruction actually read are known
+  for(uInt32 i = 0; i < 2; ++i)
+    if(myTraceOperandMask & (1 << i))
+      entry.operand[i] = myTraceOperands[i];
+
+  entry.a = A;
+  entry.x = X;
+  entry.y = Y;
+  entry.sp = SP;
+  entry.ps = PS();
+
+  myTrace->add(entry);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::interruptHandler()
 {
@@ -661,10 +821,55 @@ const StringList& M6502::getCondTrapNames() const
   return myTrapCondNames;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502::setRunTo(const RunToPCs* pcs, Expression* whileCond)
+{
+  myRunToPCs = pcs;
+  myRunWhileCond = whileCond;
+  myRunToActive = true;
+  myRunToHit = false;
+
+  // Always execute at least one instruction
+  myLastBreakCycle = mySystem->cycles();
+
+  updateStepStateByInstruction();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool M6502::clearRunTo()
+{
+  const bool hit = myRunToHit;
+
+  myRunToPCs = nullptr;
+  myRunWhileCond = nullptr;
+  myRunToActive = myRunToHit = false;
+
+  updateStepStateByInstruction();
+
+  return hit;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502::profileInstruction(uInt16 pc, uInt16 bank, uInt64 startCycle)
+{
+  // Charge a WSYNC halt to the instruction which requested it, and remember
+  // how much of the scanline was used until then
+  if(myHaltRequested)
+  {
+    const TIA& tia = mySystem->tia();
+
+    myProfiler->addScanline(tia.scanlines(),
+                            tia.clocksThisLine() / TIAConstants::CYCLE_CLOCKS);
+    handleHalt();
+  }
+
+  myProfiler->addInstruction(pc, bank, uInt32(mySystem->cycles() - startCycle));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::updateStepStateByInstruction()
 {
   myStepStateByInstruction = myCondBreaks.size() || myCondSaveStates.size() ||
-                             myTrapConds.size();
+                             myTrapConds.size() || myRunWhileCond;
 }
 #endif  // DEBUGGER_SUPPORT
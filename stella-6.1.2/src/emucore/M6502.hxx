@@ -31,9 +31,11 @@ class DispatchResult;
   #include "Expression.hxx"
   #include "TrapArray.hxx"
   #include "BreakpointMap.hxx"
+  #include "CycleProfiler.hxx"
 #endif
 
 #include "bspf.hxx"
+#include "InstructionTrace.hxx"
 #include "Serializable.hxx"
 
 /**
@@ -193,6 +195,20 @@ class M6502 : public Serializable
     */
     uInt32 distinctAccesses() const { return myNumberOfDistinctAccesses; }
 
+    /**
+      Get the number of cycles which were skipped in idle loops polling
+      the timer (since the last reset)
+
+      @return The number of skipped cycles
+    */
+    uInt64 idleCyclesSkipped() const { return myIdleCyclesSkipped; }
+
+    /**
+      Record every executed instruction into the given trace buffer
+      (nullptr disables tracing).
+    */
+    void setTrace(InstructionTrace* trace) { myTrace = trace; }
+
     /**
       Saves the current state of this device to the given Serializer.
 
@@ -237,6 +253,17 @@ class M6502 : public Serializable
     void clearCondTraps();
     const StringList& getCondTrapNames() const;
 
+    // methods for 'runto', 'runtopc' and 'stepwhile' handling; execution
+    // stops once PC hits one of the addresses (in its bank, like a
+    // breakpoint), or 'whileCond' evaluates false, whichever comes first
+    using RunToPCs = BreakpointMap;
+    void setRunTo(const RunToPCs* pcs, Expression* whileCond);
+    bool clearRunTo();
+    bool runToHit() const { return myRunToHit; }
+
+    // Collect cycle statistics into the given profiler (null disables)
+    void setProfiler(CycleProfiler* profiler) { myProfiler = profiler; }
+
     void setGhostReadsTrap(bool enable) { myGhostReadsTrap = enable; }
     void setReadFromWritePortBreak(bool enable) { myReadFromWritePortBreak = enable; }
     void setWriteToReadPortBreak(bool enable) { myWriteToReadPortBreak = enable; }
@@ -316,12 +343,36 @@ class M6502 : public Serializable
     */
     void _execute(uInt64 cycles, DispatchResult& result);
 
+    /**
+      Check whether the last instruction is part of a loop which only polls
+      INTIM (e.g. 'lda INTIM / bne loop') and skip the loop iterations which
+      won't read zero, up to the given cycle.
+
+      @param address   The address accessed by the last instruction
+      @param endCycle  The cycle at which the current timeslice ends
+    */
+    void checkIdleLoop(uInt16 address, uInt64 endCycle);
+    void skipIdleLoop(uInt64 endCycle);
+
+    /**
+      Record the instruction just executed in the trace buffer.
+
+      @param pc    The address of the opcode
+      @param bank  The bank 'pc' was mapped to when the opcode was fetched
+    */
+    void traceInstruction(uInt16 pc, uInt16 bank);
+
 #ifdef DEBUGGER_SUPPORT
     /**
       Check whether we are required to update hardware (TIA + RIOT) in lockstep
       with the CPU and update the flag accordingly.
     */
     void updateStepStateByInstruction();
+
+    /**
+      Account the instruction just executed to the profiler.
+    */
+    void profileInstruction(uInt16 pc, uInt16 bank, uInt64 startCycle);
 #endif  // DEBUGGER_SUPPORT
 
   private:
@@ -367,6 +418,26 @@ class M6502 : public Serializable
     /// Indicates the last address which was accessed
     uInt16 myLastAddress{0};
 
+    /// Idle loop detection: start address of the last instruction which
+    /// loaded INTIM, the accessed address and the cycle when it finished
+    uInt16 myIdleLoopPC{0};
+    uInt16 myIdleLoopAddress{0};
+    uInt64 myIdleLoopCycle{0};
+
+    /// Indicates whether idle loops are skipped, and the number of cycles
+    /// skipped so far
+    bool myIdleSkip{true};
+    uInt64 myIdleCyclesSkipped{0};
+
+    /// The instruction trace buffer, if tracing is enabled
+    InstructionTrace* myTrace{nullptr};
+
+    /// The bytes following the opcode of the traced instruction, as they
+    /// were fetched (bits 0 and 1 of the mask tell which ones were read)
+    uInt16 myTracePC{0};
+    std::array<uInt8, 2> myTraceOperands;
+    uInt8 myTraceOperandMask{0};
+
     /// Last cycle that triggered a breakpoint
     uInt64 myLastBreakCycle{ULLONG_MAX};
 
@@ -426,6 +497,8 @@ class M6502 : public Serializable
       return -1; // no trapif hit
     }
 
+    bool runToReached() const;
+
     /// Pointer to the debugger for this processor or the null pointer
     Debugger* myDebugger{nullptr};
 
@@ -448,6 +521,13 @@ class M6502 : public Serializable
     StringList myCondSaveStateNames;
     vector<unique_ptr<Expression>> myTrapConds;
     StringList myTrapCondNames;
+
+    // Temporary stop conditions for 'runto', 'runtopc' and 'stepwhile'
+    const RunToPCs* myRunToPCs{nullptr};
+    Expression* myRunWhileCond{nullptr};
+    bool myRunToActive{false}, myRunToHit{false};
+
+    CycleProfiler* myProfiler{nullptr};
 #endif  // DEBUGGER_SUPPORT
 
     bool myGhostReadsTrap{false};          // trap on ghost reads
@@ -60,11 +60,13 @@ void M6532::reset()
 
   myTimer = mySystem->randGenerator().next() & 0xff;
   myDivider = 1024;
+  myDividerShift = 10;
   mySubTimer = 0;
   myTimerWrapped = false;
   myWrappedThisCycle = false;
 
   mySetTimerCycle = myLastCycle = 0;
+  scheduleTimerWrap();
 
   // Zero the I/O registers
   myDDRA = myDDRB = myOutA = myOutB = 0x00;
@@ -113,39 +115,56 @@ void M6532::update()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6532::updateEmulation()
 {
-  uInt32 cycles = uInt32(mySystem->cycles() - myLastCycle);
-  uInt32 subTimer = mySubTimer;
+  const uInt64 cycles = mySystem->cycles();
+  const uInt32 subTimerMask = myDivider - 1;
 
   // Guard against further state changes if the debugger alread forwarded emulation
   // state (in particular myWrappedThisCycle)
-  if (cycles == 0) return;
+  if (cycles == myLastCycle) return;
 
   myWrappedThisCycle = false;
-  mySubTimer = (cycles + mySubTimer) % myDivider;
 
-  if(!myTimerWrapped)
+  if(myTimerWrapped)
   {
-    uInt32 timerTicks = (cycles + subTimer) / myDivider;
+    // Once wrapped, the timer decrements on every cycle
+    const uInt64 elapsed = cycles - myLastCycle;
 
-    if(timerTicks > myTimer)
-    {
-      cycles -= ((myTimer + 1) * myDivider - subTimer);
-      myWrappedThisCycle = cycles == 0;
-      myTimer = 0xFF;
-      myTimerWrapped = true;
-      myInterruptFlag |= TimerBit;
-    }
-    else
-    {
-      myTimer -= timerTicks;
-      cycles = 0;
-    }
+    myTimer = uInt8(myTimer - elapsed);
+    mySubTimer = uInt32(mySubTimer + elapsed) & subTimerMask;
   }
+  else if(cycles < myWrapCycle)
+  {
+    const uInt64 remaining = myWrapCycle - cycles;
 
-  if(myTimerWrapped)
-    myTimer = (myTimer - cycles) & 0xFF;
+    myTimer = uInt8((remaining - 1) >> myDividerShift);
+    mySubTimer = (myDivider - uInt32(remaining & subTimerMask)) & subTimerMask;
+  }
+  else
+  {
+    const uInt64 elapsed = cycles - myWrapCycle;
+
+    myWrappedThisCycle = elapsed == 0;
+    myTimer = uInt8(0xFF - elapsed);
+    mySubTimer = uInt32(elapsed) & subTimerMask;
+    myTimerWrapped = true;
+    myInterruptFlag |= TimerBit;
+  }
 
-  myLastCycle = mySystem->cycles();
+  myLastCycle = cycles;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 M6532::timerZeroCycle()
+{
+  updateEmulation();
+
+  return myTimerWrapped ? 0 : myWrapCycle - myDivider;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6532::scheduleTimerWrap()
+{
+  myWrapCycle = myLastCycle + uInt64(myTimer + 1) * myDivider - mySubTimer;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -179,14 +198,16 @@ void M6532::installDelegate(System& system, Device& device)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8 M6532::peek(uInt16 addr)
 {
-  updateEmulation();
-
   // A9 distinguishes I/O registers from ZP RAM
   // A9 = 1 is read from I/O
   // A9 = 0 is read from RAM
   if((addr & 0x0200) == 0x0000)
     return myRAM[addr & 0x007f];
 
+  // Only the I/O registers depend on the timer, so RAM accesses don't need to
+  // catch up with it
+  updateEmulation();
+
   switch(addr & 0x07)
   {
     case 0x00:    // SWCHA - Port A I/O Register (Joystick)
@@ -222,6 +243,7 @@ uInt8 M6532::peek(uInt16 addr)
       // Timer Flag is always cleared when accessing INTIM
       if (!myWrappedThisCycle) myInterruptFlag &= ~TimerBit;
       myTimerWrapped = false;
+      scheduleTimerWrap();
       return myTimer;
     }
 
@@ -247,8 +269,6 @@ uInt8 M6532::peek(uInt16 addr)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool M6532::poke(uInt16 addr, uInt8 value)
 {
-  updateEmulation();
-
   // A9 distinguishes I/O registers from ZP RAM
   // A9 = 1 is write to I/O
   // A9 = 0 is write to RAM
@@ -258,6 +278,8 @@ bool M6532::poke(uInt16 addr, uInt8 value)
     return true;
   }
 
+  updateEmulation();
+
   // A2 distinguishes I/O registers from the timer
   // A2 = 1 is write to timer
   // A2 = 0 is write to I/O
@@ -308,8 +330,10 @@ bool M6532::poke(uInt16 addr, uInt8 value)
 void M6532::setTimerRegister(uInt8 value, uInt8 interval)
 {
   static constexpr std::array<uInt32, 4> divider = { 1, 8, 64, 1024 };
+  static constexpr std::array<uInt32, 4> dividerShift = { 0, 3, 6, 10 };
 
   myDivider = divider[interval];
+  myDividerShift = dividerShift[interval];
   myOutTimer[interval] = value;
 
   myTimer = value;
@@ -320,6 +344,7 @@ void M6532::setTimerRegister(uInt8 value, uInt8 interval)
   myInterruptFlag &= ~TimerBit;
 
   mySetTimerCycle = mySystem->cycles();
+  scheduleTimerWrap();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -399,10 +424,14 @@ bool M6532::load(Serializer& in)
     myTimer = in.getInt();
     mySubTimer = in.getInt();
     myDivider = in.getInt();
+    myDividerShift = 0;
+    while((1u << myDividerShift) < myDivider)
+      ++myDividerShift;
     myTimerWrapped = in.getBool();
     myWrappedThisCycle = in.getBool();
     myLastCycle = in.getLong();
     mySetTimerCycle = in.getLong();
+    scheduleTimerWrap();
 
     myDDRA = in.getByte();
     myDDRB = in.getByte();
@@ -123,6 +123,14 @@ class M6532 : public Device
      */
     void updateEmulation();
 
+    /**
+      Get the cycle from which on INTIM will read zero. This is only known
+      while the timer hasn't wrapped; otherwise, 0 is returned.
+
+      @return  The first cycle with INTIM = 0, or 0
+    */
+    uInt64 timerZeroCycle();
+
     /**
       Get a pointer to the RAM contents.
 
@@ -130,9 +138,23 @@ class M6532 : public Device
     */
     const uInt8* getRAM() const { return myRAM.data(); }
 
+    /**
+      Get a writable pointer to the RAM contents, for frontends which
+      expose the RAM directly (writing it has no side effects).
+
+      @return  Pointer to RAM array.
+    */
+    uInt8* getRAM() { return myRAM.data(); }
+
   private:
 
     void setTimerRegister(uInt8 data, uInt8 interval);
+
+    /**
+      Calculate the cycle at which the (running) timer will wrap, from the
+      timer state at myLastCycle.
+    */
+    void scheduleTimerWrap();
     void setPinState(bool shcha);
 
 #ifdef DEBUGGER_SUPPORT
@@ -177,13 +199,18 @@ class M6532 : public Device
     // Current number of clocks "queued" for the divider
     uInt32 mySubTimer{0};
 
-    // The divider
+    // The divider, and the equivalent shift (the divider is a power of two)
     uInt32 myDivider{1};
+    uInt32 myDividerShift{0};
 
     // Has the timer wrapped?
     bool myTimerWrapped{false};
     bool myWrappedThisCycle{false};
 
+    // As long as the timer hasn't wrapped, the cycle at which it will wrap;
+    // the timer value and the timer flag follow from this in closed form
+    uInt64 myWrapCycle{0};
+
     // Cycle when the timer set. Debugging only.
     uInt64 mySetTimerCycle{0};
 
@@ -69,17 +69,24 @@ MT24LC256::MT24LC256(const string& filename, const System& system,
   jpee_init();
 
   systemReset();
+  myPageDirty.fill(false);
+
+  // A missing data file is created as a whole on the first write
+  myRewriteFile = !myDataFileExists;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 MT24LC256::~MT24LC256()
 {
-  // Save EEPROM data to external file only when necessary
-  if(!myDataFileExists || myDataChanged)
+  // Wait until the writer has saved all remaining changes
+  if(myWriter.joinable())
   {
-    ofstream out(myDataFile, std::ios_base::binary);
-    if(out.is_open())
-      out.write(reinterpret_cast<char*>(myData.data()), myData.size());
+    {
+      std::lock_guard<std::mutex> lock(myMutex);
+      myStopWriter = true;
+    }
+    myWakeup.notify_one();
+    myWriter.join();
   }
 }
 
@@ -139,8 +146,10 @@ void MT24LC256::eraseAll()
   // Work around a bug in XCode 11.2 with -O0 and -O1
   const uInt8 initialValue = INITIAL_VALUE;
 
+  std::lock_guard<std::mutex> lock(myMutex);
   myData.fill(initialValue);
-  myDataChanged = true;
+  myPageDirty.fill(true);
+  requestWrite();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -148,15 +157,19 @@ void MT24LC256::eraseCurrent()
 {
   // Work around a bug in XCode 11.2 with -O0 and -O1
   const uInt8 initialValue = INITIAL_VALUE;
+  bool changed = false;
 
+  std::lock_guard<std::mutex> lock(myMutex);
   for(uInt32 page = 0; page < PAGE_NUM; ++page)
   {
     if(myPageHit[page])
     {
       std::fill_n(myData.begin() + page * PAGE_SIZE, PAGE_SIZE, initialValue);
-      myDataChanged = true;
+      myPageDirty[page] = changed = true;
     }
   }
+  if(changed)
+    requestWrite();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -236,16 +249,19 @@ void MT24LC256::jpee_data_stop()
       jpee_pptr = 4+jpee_pagemask-(jpee_address & jpee_pagemask);
       JPEE_LOG1("I2C_WARNING PAGECROSSING!(Truncate to %d bytes)",jpee_pptr-3)
     }
-    for (int i=3; i<jpee_pptr; i++)
+    myCallback("AtariVox/SaveKey EEPROM write");
     {
-      myDataChanged = true;
-      myPageHit[jpee_address / PAGE_SIZE] = true;
-
-      myCallback("AtariVox/SaveKey EEPROM write");
+      std::lock_guard<std::mutex> lock(myMutex);
+      for (int i=3; i<jpee_pptr; i++)
+      {
+        myPageHit[jpee_address / PAGE_SIZE] = true;
+        myPageDirty[(jpee_address & jpee_sizemask) / PAGE_SIZE] = true;
 
-      myData[(jpee_address++) & jpee_sizemask] = jpee_packet[i];
-      if (!(jpee_address & jpee_pagemask))
-        break;  /* Writes can't cross page boundary! */
+        myData[(jpee_address++) & jpee_sizemask] = jpee_packet[i];
+        if (!(jpee_address & jpee_pagemask))
+          break;  /* Writes can't cross page boundary! */
+      }
+      requestWrite();
     }
     jpee_ad_known = 0;
   }
@@ -396,3 +412,63 @@ bool MT24LC256::jpee_timercheck(int mode)
     return myTimerActive;
   }
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MT24LC256::requestWrite()
+{
+  myWritePending = true;
+
+  // Many instances never write to the EEPROM, so the thread is only
+  // created when it is first needed
+  if(!myWriter.joinable())
+    myWriter = std::thread(&MT24LC256::writePages, this);
+  else
+    myWakeup.notify_one();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MT24LC256::writePages()
+{
+  std::array<uInt8, FLASH_SIZE> data;
+  std::array<bool, PAGE_NUM> dirty;
+  bool rewrite = false;
+
+  std::unique_lock<std::mutex> lock(myMutex);
+  for(;;)
+  {
+    myWakeup.wait(lock, [this]{ return myWritePending || myStopWriter; });
+    if(!myWritePending)
+      break;
+
+    // Take a snapshot, so the file is written without blocking the emulation
+    data = myData;
+    dirty = myPageDirty;
+    rewrite = myRewriteFile;
+    myPageDirty.fill(false);
+    myWritePending = myRewriteFile = false;
+    lock.unlock();
+
+    fstream file;
+    if(!rewrite)
+      file.open(myDataFile, std::ios_base::binary | std::ios_base::in | std::ios_base::out);
+
+    if(file.is_open())
+    {
+      for(uInt32 page = 0; page < PAGE_NUM; ++page)
+        if(dirty[page])
+        {
+          file.seekp(page * PAGE_SIZE);
+          file.write(reinterpret_cast<char*>(data.data()) + page * PAGE_SIZE, PAGE_SIZE);
+        }
+    }
+    else
+    {
+      // The file doesn't exist (anymore), or had an invalid size
+      ofstream out(myDataFile, std::ios_base::binary | std::ios_base::trunc);
+      if(out.is_open())
+        out.write(reinterpret_cast<char*>(data.data()), data.size());
+    }
+
+    lock.lock();
+  }
+}
@@ -20,6 +20,10 @@
 
 class System;
 
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
 #include "Control.hxx"
 #include "bspf.hxx"
 
@@ -28,6 +32,10 @@ class System;
   Erasable PROM accessed using the I2C protocol.  Thanks to J. Payson
   (aka Supercat) for the bulk of this code.
 
+  The data file is read once on creation.  Changed pages are written back
+  in place by a background thread shortly after each write, so the file
+  is always (nearly) up to date and is never rewritten as a whole.
+
   @author  Stephen Anthony & J. Payson
 */
 class MT24LC256
@@ -83,6 +91,13 @@ class MT24LC256
 
     void update();
 
+    // Schedule the changed pages to be written to the data file
+    // Must be called with 'myMutex' locked
+    void requestWrite();
+
+    // Body of the writer thread
+    void writePages();
+
   private:
     // The system of the parent controller
     const System& mySystem;
@@ -115,8 +130,18 @@ class MT24LC256
     // Indicates if a valid EEPROM data file exists/was successfully loaded
     bool myDataFileExists{false};
 
-    // Indicates if the EEPROM has changed since class invocation
-    bool myDataChanged{false};
+    // Pages changed since they were last written to the data file
+    std::array<bool, PAGE_NUM> myPageDirty;
+
+    // The data file must be created (or replaced) as a whole
+    bool myRewriteFile{false};
+
+    // Writes the changed pages in the background (started on demand);
+    // 'myMutex' guards the EEPROM data, the dirty pages and the flags below
+    std::thread myWriter;
+    std::mutex myMutex;
+    std::condition_variable myWakeup;
+    bool myWritePending{false}, myStopWriter{false};
 
     // Required for I2C functionality
     Int32 jpee_mdat{0}, jpee_sdat{0}, jpee_mclk{0};
@@ -0,0 +1,89 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef MUSIC_CLOCK_HXX
+#define MUSIC_CLOCK_HXX
+
+#include "bspf.hxx"
+
+/**
+  The oscillator which clocks the music data fetchers of the DPC, DPC+,
+  BUS, CDF and CTY carts.
+
+  Elapsed CPU cycles are converted into oscillator clocks with a 24.40
+  fixed-point phase accumulator, so any number of cycles is handled by a
+  single multiplication, and the fractional clock is carried over to the
+  next update.
+*/
+class MusicClock
+{
+  public:
+    explicit MusicClock(double frequency = 20000.0) { setFrequency(frequency); }
+
+    /**
+      Set the oscillator frequency (in Hz).
+    */
+    void setFrequency(double frequency) {
+      myStep = uInt64(frequency * ONE / CPU_CLOCK + 0.5);
+    }
+
+    /**
+      Advance the oscillator by the given number of CPU cycles.
+
+      @return  The number of whole oscillator clocks which elapsed
+    */
+    uInt32 advance(uInt32 cycles) {
+      uInt32 clocks = 0;
+
+      // Very long intervals are split, so that the product can't overflow
+      for(; cycles > MAX_CYCLES; cycles -= MAX_CYCLES)
+        clocks += step(MAX_CYCLES);
+
+      return clocks + step(cycles);
+    }
+
+    void reset() { myPhase = 0; }
+
+    /**
+      The fraction of an oscillator clock not consumed yet; this is what
+      the carts store in their states.
+    */
+    double fraction() const { return double(myPhase) / ONE; }
+    void setFraction(double fraction) {
+      myPhase = uInt64(BSPF::clamp(fraction, 0.0, 1.0) * ONE) & (ONE - 1);
+    }
+
+  private:
+    uInt32 step(uInt32 cycles) {
+      myPhase += myStep * cycles;
+      const uInt32 clocks = uInt32(myPhase >> FRACTION_BITS);
+      myPhase &= ONE - 1;
+
+      return clocks;
+    }
+
+  private:
+    static constexpr uInt32 FRACTION_BITS = 40;
+    static constexpr uInt64 ONE = uInt64(1) << FRACTION_BITS;
+    static constexpr uInt32 MAX_CYCLES = 1 << 20;
+    static constexpr double CPU_CLOCK = 1193191.66666667;
+
+    uInt64 myStep{0};   // clocks per CPU cycle, in 24.40 fixed-point
+    uInt64 myPhase{0};  // fraction of the current clock, in 0.40 fixed-point
+};
+
+#endif
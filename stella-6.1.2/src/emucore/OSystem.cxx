@@ -23,6 +23,8 @@
 
 #include "MediaFactory.hxx"
 #include "Sound.hxx"
+#include "SoundNull.hxx"
+#include "FrameBufferNull.hxx"
 
 #ifdef CHEATCODE_SUPPORT
   #include "CheatManager.hxx"
@@ -47,6 +49,7 @@
 #include "MD5.hxx"
 #include "Cart.hxx"
 #include "CartDetector.hxx"
+#include "DetectionCache.hxx"
 #include "FrameBuffer.hxx"
 #include "TIASurface.hxx"
 #include "TIAConstants.hxx"
@@ -65,6 +68,7 @@
 #include "AudioSettings.hxx"
 #include "repository/KeyValueRepositoryNoop.hxx"
 #include "repository/KeyValueRepositoryConfigfile.hxx"
+#include "M6502.hxx"
 #include "M6532.hxx"
 
 #include "OSystem.hxx"
@@ -161,7 +165,7 @@ bool OSystem::create()
   createSound();
 
   // Create random number generator
-  myRandom = make_unique<Random>(uInt32(TimerManager::getTicks()));
+  myRandom = make_unique<Random>(randomSeed());
 
 #ifdef CHEATCODE_SUPPORT
   myCheatManager = make_unique<CheatManager>(*this);
@@ -182,11 +186,47 @@ bool OSystem::create()
   myPNGLib = make_unique<PNGLibrary>(*this);
 #endif
 
-  myPropSet->load(myPropertiesFile);
+  if(!ourUseDefaultConfig)
+    myPropSet->load(myPropertiesFile);
 
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool OSystem::createHeadless()
+{
+  myHeadless = true;
+
+  // Many subsystems show messages on the framebuffer, which are
+  // silently dropped by a Null framebuffer
+  myFrameBuffer = make_unique<FrameBufferNull>(*this);
+
+  myEventHandler = MediaFactory::createEventHandler(*this);
+  myEventHandler->initialize();
+
+  myStateManager = make_unique<StateManager>(*this);
+  myTimerManager = make_unique<TimerManager>();
+  myAudioSettings = make_unique<AudioSettings>(*mySettings);
+  mySound = make_unique<SoundNull>(*this);
+  myRandom = make_unique<Random>(randomSeed());
+
+#ifdef CHEATCODE_SUPPORT
+  myCheatManager = make_unique<CheatManager>(*this);
+  myCheatManager->loadCheatDatabase();
+#endif
+
+  if(!ourUseDefaultConfig)
+    myPropSet->load(myPropertiesFile);
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 OSystem::randomSeed() const
+{
+  return myHeadless ? 0 : uInt32(TimerManager::getTicks());
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void OSystem::loadConfig(const Settings::Options& options)
 {
@@ -214,13 +254,22 @@ void OSystem::loadConfig(const Settings::Options& options)
     load.makeDir();
   myDefaultLoadDir = load.getShortPath();
 
-#ifdef SQLITE_SUPPORT
-  mySettingsDb = make_shared<SettingsDb>(myBaseDir, "settings");
-  if(!mySettingsDb->initialize())
-    mySettingsDb.reset();
-#endif
+  if(ourUseDefaultConfig)
+  {
+    mySettings->setRepository(make_shared<KeyValueRepositoryNoop>());
+    myDetectionCache = make_unique<DetectionCache>(make_shared<KeyValueRepositoryNoop>());
+  }
+  else
+  {
+  #ifdef SQLITE_SUPPORT
+    mySettingsDb = make_shared<SettingsDb>(myBaseDir, "settings");
+    if(!mySettingsDb->initialize())
+      mySettingsDb.reset();
+  #endif
 
-  mySettings->setRepository(createSettingsRepository());
+    mySettings->setRepository(createSettingsRepository());
+    myDetectionCache = make_unique<DetectionCache>(createDetectionRepository());
+  }
 
   mySettings->load(options);
 
@@ -433,6 +482,11 @@ string OSystem::createConsole(const FilesystemNode& rom, const string& md5sum,
     }
     myConsole->initializeAudio();
 
+    const string& capture = mySettings->getString("capture");
+    if(capture != "" &&
+       !myConsole->startCapture(capture, mySettings->getString("captureformat")))
+      Logger::error("ERROR: Couldn't create capture files for " + capture);
+
     string saveOnExit = settings().getString("saveonexit");
     bool activeTM = settings().getBool(
       settings().getBool("dev.settings") ? "dev.timemachine" : "plr.timemachine");
@@ -467,6 +521,38 @@ string OSystem::createConsole(const FilesystemNode& rom, const string& md5sum,
   return EmptyString;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string OSystem::createHeadlessConsole(const FilesystemNode& rom)
+{
+  myRomFile = rom;
+  myRomMD5  = "";
+  mySettings->setValue("romloadcount", 0);
+
+  try
+  {
+    closeConsole();
+    myConsole = openConsole(myRomFile, myRomMD5);
+  }
+  catch(const runtime_error& e)
+  {
+    ostringstream buf;
+    buf << "ERROR: Couldn't create console (" << e.what() << ")";
+    return buf.str();
+  }
+  if(!myConsole)
+    return "ERROR: Couldn't create console";
+
+#ifdef DEBUGGER_SUPPORT
+  // Only the dialog is missing; the debugger works as usual
+  myDebugger = make_unique<Debugger>(*this, *myConsole);
+  myConsole->attachDebugger(*myDebugger);
+#endif
+  myEventHandler->setState(EventHandlerState::EMULATION);
+  myConsole->riot().update();
+
+  return EmptyString;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool OSystem::reloadConsole()
 {
@@ -563,7 +649,8 @@ unique_ptr<Console> OSystem::openConsole(const FilesystemNode& romfile, string&
     string cartmd5 = md5;
     const string& type = props.get(PropType::Cart_Type);
     unique_ptr<Cartridge> cart =
-      CartDetector::create(romfile, image, size, cartmd5, type, *mySettings);
+      CartDetector::create(romfile, image, size, cartmd5, type, *mySettings,
+                           myDetectionCache.get());
 
     // Some properties may not have a name set; we can't leave it blank
     if(props.get(PropType::Cart_Name) == EmptyString)
@@ -679,9 +766,20 @@ double OSystem::dispatchEmulation(EmulationWorker& emulationWorker)
   TIA& tia(myConsole->tia());
   EmulationTiming& timing(myConsole->emulationTiming());
   DispatchResult dispatchResult;
+  const bool turbo = myConsole->turbo();
 
   // Check whether we have a frame pending for rendering...
   bool framePending = tia.newFramePending();
+  // ... in turbo mode, the frames in between are dropped (but still counted by
+  // the FPS meter, which thus shows the emulated framerate)
+  if (framePending && turbo) {
+    const auto now = high_resolution_clock::now();
+
+    if (now - myLastTurboRender < duration<double>(1. / TURBO_RENDER_RATE))
+      framePending = false;
+    else
+      myLastTurboRender = now;
+  }
   // ... and copy it to the frame buffer. It is important to do this before
   // the worker is started to avoid racing.
   if (framePending) {
@@ -691,13 +789,20 @@ double OSystem::dispatchEmulation(EmulationWorker& emulationWorker)
 
   // Start emulation on a dedicated thread. It will do its own scheduling to sync 6507 and real time
   // and will run until we stop the worker.
-  emulationWorker.start(
-    timing.cyclesPerSecond(),
-    timing.maxCyclesPerTimeslice(),
-    timing.minCyclesPerTimeslice(),
-    &dispatchResult,
-    &tia
-  );
+  if (turbo) {
+    // In turbo mode, the worker runs unthrottled and emulates a batch of frames
+    const uInt64 turboCycles = uInt64(timing.cyclesPerFrame()) * TURBO_FRAMES_PER_TIMESLICE;
+
+    emulationWorker.start(timing.cyclesPerSecond(), turboCycles, turboCycles, &dispatchResult, &tia, false);
+  }
+  else
+    emulationWorker.start(
+      timing.cyclesPerSecond(),
+      timing.maxCyclesPerTimeslice(),
+      timing.minCyclesPerTimeslice(),
+      &dispatchResult,
+      &tia
+    );
 
   // Render the frame. This may block, but emulation will continue to run on the worker, so the
   // audio pipeline is kept fed :)
@@ -738,8 +843,83 @@ double OSystem::dispatchEmulation(EmulationWorker& emulationWorker)
   if (dispatchResult.getStatus() == DispatchResult::Status::ok && myEventHandler->frying())
     myConsole->fry();
 
-  // Return the 6507 time used in seconds
-  return static_cast<double>(totalCycles) / static_cast<double>(timing.cyclesPerSecond());
+  // Return the 6507 time used in seconds; in turbo mode, we don't wait for real time to catch up
+  return turbo ? 0. : static_cast<double>(totalCycles) / static_cast<double>(timing.cyclesPerSecond());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystem::checkRomFile()
+{
+  // The emulation may have just entered the debugger
+  if (myEventHandler->state() != EventHandlerState::EMULATION) return;
+
+  const auto now = high_resolution_clock::now();
+  if (now < myNextRomCheck) return;
+  myNextRomCheck = now + milliseconds(ROM_CHECK_INTERVAL);
+
+  const string& mode = mySettings->getString("romwatch");
+  if (mode != "keep" && mode != "cpu") return;
+
+  ByteBuffer image;
+  size_t size = 0;
+  try
+  {
+    size = myRomFile.read(image);
+  }
+  catch(const runtime_error&)
+  {
+    // The file may be rewritten right now; try again next time
+    return;
+  }
+
+  string md5 = MD5::hash(image, size);
+  if (size == 0 || md5 == myRomMD5)
+  {
+    myChangedRomMD5 = "";
+    return;
+  }
+
+  // An assembler may still be writing the file, so wait until it
+  // stays the same for a full interval
+  if (md5 != myChangedRomMD5)
+  {
+    myChangedRomMD5 = md5;
+    return;
+  }
+  myChangedRomMD5 = "";
+
+  // The new image must be of the same bankswitch type
+  Cartridge& cart = myConsole->cartridge();
+  Bankswitch::Type type =
+    Bankswitch::nameToType(myConsole->properties().get(PropType::Cart_Type));
+  if (type == Bankswitch::Type::_AUTO)
+    type = Bankswitch::typeFromExtension(myRomFile);
+  if (type == Bankswitch::Type::_AUTO)
+    type = CartDetector::autodetectType(image, size);
+
+  if (cart.multiCartID() == "" &&
+      type == Bankswitch::nameToType(cart.detectedType()) &&
+      cart.reload(image, size))
+  {
+    myRomMD5 = md5;
+    if (mode == "cpu")
+      myConsole->system().m6502().reset();
+  #ifdef DEBUGGER_SUPPORT
+    // The disassembly is redone the next time the debugger is entered
+    myDebugger->invalidateRom(false);
+  #endif
+
+    myFrameBuffer->showMessage("ROM reloaded");
+    Logger::info("ROM reloaded: " + myRomFile.getShortPath());
+  }
+  else
+  {
+    // The new console is created with the MD5 of the new image
+    const string oldMD5 = myRomMD5;
+    myRomMD5 = md5;
+    if (!reloadConsole())
+      myRomMD5 = oldMD5;
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -766,9 +946,13 @@ void OSystem::mainLoop()
 
     double timesliceSeconds;
 
-    if (myEventHandler->state() == EventHandlerState::EMULATION)
+    if (myEventHandler->state() == EventHandlerState::EMULATION) {
       // Dispatch emulation and render frame (if applicable)
       timesliceSeconds = dispatchEmulation(emulationWorker);
+
+      // The worker is stopped now, so the cartridge can be changed
+      checkRomFile();
+    }
     else {
       // Render the GUI with 60 Hz in all other modes
       timesliceSeconds = 1. / 60.;
@@ -820,6 +1004,19 @@ shared_ptr<KeyValueRepository> OSystem::createSettingsRepository()
   #endif
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+shared_ptr<KeyValueRepository> OSystem::createDetectionRepository()
+{
+  // Without a database, detection results are only cached for this run
+  #ifdef SQLITE_SUPPORT
+    if(mySettingsDb)
+      return shared_ptr<KeyValueRepository>(mySettingsDb, &mySettingsDb->detectionRepository());
+  #endif
+
+  return make_shared<KeyValueRepositoryNoop>();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string OSystem::ourOverrideBaseDir = "";
 bool OSystem::ourOverrideBaseDirWithApp = false;
+bool OSystem::ourUseDefaultConfig = false;
@@ -29,6 +29,7 @@ class StateManager;
 class TimerManager;
 class EmulationWorker;
 class AudioSettings;
+class DetectionCache;
 #ifdef CHEATCODE_SUPPORT
   class CheatManager;
 #endif
@@ -81,6 +82,13 @@ class OSystem
     */
     virtual bool create();
 
+    /**
+      Create only the child objects needed to emulate a console without
+      any display, sound or GUI (ie, when running debugger scripts).
+      This is used instead of create().
+    */
+    bool createHeadless();
+
     /**
       Creates the various framebuffers/renderers available in this system.
       Note that it will only create one type per run of Stella.
@@ -125,6 +133,14 @@ class OSystem
     */
     Random& random() const { return *myRandom; }
 
+    /**
+      Get a seed for the random number generator.  This is constant when
+      running headless, so the emulation is reproducible.
+
+      @return The seed
+    */
+    uInt32 randomSeed() const;
+
     /**
       Get the set of game properties for the system.
 
@@ -162,6 +178,14 @@ class OSystem
     */
     TimerManager& timer() const { return *myTimerManager; }
 
+    /**
+      Get the cache of ROM detection results (bankswitch type, frame layout,
+      controllers).
+
+      @return The detectioncache object
+    */
+    DetectionCache& detectionCache() const { return *myDetectionCache; }
+
     /**
       This method should be called to initiate the process of loading settings
       from the config file.  It takes care of loading settings, applying
@@ -334,6 +358,17 @@ class OSystem
     string createConsole(const FilesystemNode& rom, const string& md5 = "",
                          bool newrom = true);
 
+    /**
+      Creates a new game console from the specified romfile, for an OSystem
+      created by createHeadless().  The console isn't connected to any
+      display or sound, and the debugger (if any) has no dialog.
+
+      @param rom  The FSNode of the ROM to use (contains path, etc)
+
+      @return  String indicating any error message (EmptyString for no errors)
+    */
+    string createHeadlessConsole(const FilesystemNode& rom);
+
     /**
       Reloads the current console (essentially deletes and re-creates it).
       This can be thought of as a real console off/on toggle.
@@ -408,6 +443,13 @@ class OSystem
     static void overrideBaseDir(const string& path) { ourOverrideBaseDir = path; }
     static void overrideBaseDirWithApp() { ourOverrideBaseDirWithApp = true; }
 
+    /**
+      Ignore all stored settings, cached detection results and user
+      properties, and don't store any either.  This makes runs independent
+      of the local configuration and of each other (eg. for scripts).
+    */
+    static void useDefaultConfig() { ourUseDefaultConfig = true; }
+
   public:
     //////////////////////////////////////////////////////////////////////
     // The following methods are system-specific and can be overrided in
@@ -430,6 +472,8 @@ class OSystem
 
     virtual shared_ptr<KeyValueRepository> createSettingsRepository();
 
+    virtual shared_ptr<KeyValueRepository> createDetectionRepository();
+
     //////////////////////////////////////////////////////////////////////
     // The following methods are system-specific and *must* be
     // implemented in derived classes.
@@ -517,12 +561,18 @@ class OSystem
     // Pointer to the TimerManager object
     unique_ptr<TimerManager> myTimerManager;
 
+    // Pointer to the DetectionCache object
+    unique_ptr<DetectionCache> myDetectionCache;
+
     // Indicates whether ROM launcher was ever opened during this run
     bool myLauncherUsed{false};
 
     // Indicates whether to stop the main loop
     bool myQuitLoop{false};
 
+    // Indicates whether the system was created by createHeadless()
+    bool myHeadless{false};
+
   private:
     string myBaseDir;
     string myStateDir;
@@ -546,12 +596,30 @@ class OSystem
     static constexpr uInt32 FPS_METER_QUEUE_SIZE = 100;
     FpsMeter myFpsMeter{FPS_METER_QUEUE_SIZE};
 
+    // In turbo mode, each timeslice covers several frames, and frames are
+    // only rendered at a fixed rate
+    static constexpr uInt32 TURBO_FRAMES_PER_TIMESLICE = 4;
+    static constexpr uInt32 TURBO_RENDER_RATE = 30;
+    std::chrono::time_point<std::chrono::high_resolution_clock> myLastTurboRender;
+
+    // With 'romwatch' enabled, the ROM file is checked for changes in this
+    // interval (in milliseconds)
+    static constexpr uInt32 ROM_CHECK_INTERVAL = 250;
+    std::chrono::time_point<std::chrono::high_resolution_clock> myNextRomCheck;
+
+    // The MD5 of a changed ROM file on the last check; the file is only
+    // used when it didn't change anymore until the next check
+    string myChangedRomMD5;
+
     // If not empty, a hint for derived classes to use this as the
     // base directory (where all settings are stored)
     // Derived classes are free to ignore it and use their own defaults
     static string ourOverrideBaseDir;
     static bool ourOverrideBaseDirWithApp;
 
+    // Don't load or store any settings, detection results or properties
+    static bool ourUseDefaultConfig;
+
   #ifdef SQLITE_SUPPORT
     shared_ptr<SettingsDb> mySettingsDb;
   #endif
@@ -587,6 +655,15 @@ class OSystem
 
     double dispatchEmulation(EmulationWorker& emulationWorker);
 
+    /**
+      Check whether the ROM file of the current console was changed (if
+      enabled by the 'romwatch' setting), and if so, swap the new image into
+      the running cartridge once the file is complete (unchanged for one
+      check interval).  The console is only reloaded if that's not possible
+      (eg. because the size or bankswitch type changed).
+    */
+    void checkRomFile();
+
     // Following constructors and assignment operators not supported
     OSystem(const OSystem&) = delete;
     OSystem(OSystem&&) = delete;
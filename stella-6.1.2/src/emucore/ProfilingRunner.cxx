@@ -36,6 +36,9 @@
 #include "Joystick.hxx"
 #include "Random.hxx"
 #include "DispatchResult.hxx"
+#include "AudioQueue.hxx"
+#include "AVCapture.hxx"
+#include "Console.hxx"
 
 using namespace std::chrono;
 
@@ -57,12 +60,19 @@ namespace {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 ProfilingRunner::ProfilingRunner(int argc, char* argv[])
-  : profilingRuns(std::max(argc - 2, 0))
 {
   for (int i = 2; i < argc; i++) {
-    ProfilingRun& run(profilingRuns[i-2]);
-
     string arg = argv[i];
+
+    if ((arg == "-capture" || arg == "-captureformat" || arg == "-tia.audio" || arg == "-idleskip") &&
+        i + 1 < argc) {
+      mySettings.setValue(arg.substr(1), argv[++i]);
+      continue;
+    }
+
+    profilingRuns.emplace_back();
+    ProfilingRun& run(profilingRuns.back());
+
     size_t splitPoint = arg.find_first_of(':');
 
     run.romFile = splitPoint == string::npos ? arg : arg.substr(0, splitPoint);
@@ -74,6 +84,13 @@ ProfilingRunner::ProfilingRunner(int argc, char* argv[])
     }
   }
 
+  // Capture each run into separate files if there are several of them
+  const string& capture = mySettings.getString("capture");
+  if (capture != "")
+    for (size_t i = 0; i < profilingRuns.size(); i++)
+      profilingRuns[i].captureFile =
+        profilingRuns.size() > 1 ? capture + "_" + std::to_string(i + 1) : capture;
+
   mySettings.setValue("fastscbios", true);
 }
 
@@ -165,6 +182,32 @@ bool ProfilingRunner::runOne(const ProfilingRun& run)
   system.reset();
 
   EmulationTiming emulationTiming(frameLayout, consoleTiming);
+
+  AVCapture capture;
+  shared_ptr<AudioQueue> audioQueue;
+
+  if (run.captureFile != "") {
+    // Nobody plays back the audio, so the queue just wraps around; its
+    // fragments are only tapped for the capture
+    audioQueue = make_shared<AudioQueue>(
+      emulationTiming.audioFragmentSize(), emulationTiming.audioQueueCapacity(), false
+    );
+    audioQueue->ignoreOverflows(true);
+    tia.setAudioQueue(audioQueue);
+
+    if (!capture.start(run.captureFile, AVCapture::toVideoFormat(mySettings.getString("captureformat")),
+        tia.width(), tia.height(),
+        double(emulationTiming.cyclesPerSecond()) / emulationTiming.cyclesPerFrame(),
+        Console::standardPalette(consoleTiming), emulationTiming.audioSampleRate(), false)
+    ) {
+      cout << "ERROR: unable to create capture files for " << run.captureFile << endl;
+      return false;
+    }
+
+    tia.setFrameCallback([&capture](const uInt8* frameBuffer) { capture.addFrame(frameBuffer); });
+    audioQueue->setFragmentTap([&capture](const Int16* fragment, uInt32 size) { capture.addAudio(fragment, size); });
+  }
+
   uInt64 cycles = 0;
   uInt64 cyclesTarget = uInt64(run.runtime) * emulationTiming.cyclesPerSecond();
 
@@ -198,5 +241,23 @@ bool ProfilingRunner::runOne(const ProfilingRun& run)
   (cout << "100%" << endl).flush();
   cout << "real time: " << realtimeUsed << " seconds" << endl;
 
+  const uInt64 idleCycles = cpu.idleCyclesSkipped();
+  if (idleCycles > 0)
+    cout << "idle loops: " << idleCycles << " cycles skipped ("
+         << (100 * idleCycles) / cycles << "%)" << endl;
+
+  if (capture.isRunning()) {
+    tia.setFrameCallback(nullptr);
+    audioQueue->setFragmentTap(nullptr);
+
+    if (!capture.stop()) {
+      cout << "ERROR: unable to write capture files for " << run.captureFile << endl;
+      return false;
+    }
+
+    cout << "captured " << capture.frames() << " frames, "
+         << capture.audioSamples() << " audio samples" << endl;
+  }
+
   return true;
 }
@@ -38,6 +38,7 @@ class ProfilingRunner {
     struct ProfilingRun {
       string romFile;
       uInt32 runtime;
+      string captureFile;
     };
 
     struct IO: public ConsoleIO {
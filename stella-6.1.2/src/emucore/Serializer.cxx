@@ -21,6 +21,48 @@
 using std::ios;
 using std::ios_base;
 
+namespace {
+  // A stream buffer on a fixed block of memory, which is used in place
+  class MemoryBuffer : public std::streambuf
+  {
+    public:
+      MemoryBuffer(char* data, size_t size) {
+        setg(data, data, data + size);
+        setp(data, data + size);
+      }
+
+    protected:
+      pos_type seekoff(off_type off, ios_base::seekdir dir,
+                       ios_base::openmode which) override
+      {
+        const off_type size = egptr() - eback();
+        off_type pos = -1;
+
+        if(which & ios_base::in)
+        {
+          pos = (dir == ios_base::beg ? 0 : dir == ios_base::cur ? gptr() - eback() : size) + off;
+          if(pos < 0 || pos > size)
+            return pos_type(off_type(-1));
+          setg(eback(), eback() + pos, egptr());
+        }
+        if(which & ios_base::out)
+        {
+          pos = (dir == ios_base::beg ? 0 : dir == ios_base::cur ? pptr() - pbase() : size) + off;
+          if(pos < 0 || pos > size)
+            return pos_type(off_type(-1));
+          setp(pbase(), epptr());
+          pbump(int(pos));
+        }
+        return pos_type(pos);
+      }
+
+      pos_type seekpos(pos_type pos, ios_base::openmode which) override
+      {
+        return seekoff(off_type(pos), ios_base::beg, which);
+      }
+  };
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Serializer::Serializer(const string& filename, Mode m)
   : myStream(nullptr)
@@ -80,6 +122,21 @@ Serializer::Serializer()
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Serializer::Serializer(uInt8* buffer, size_t size)
+  : myBuffer(make_unique<MemoryBuffer>(reinterpret_cast<char*>(buffer), size)),
+    myStream(make_unique<iostream>(myBuffer.get()))
+{
+  myStream->exceptions( ios_base::failbit | ios_base::badbit | ios_base::eofbit );
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Serializer::Serializer(const uInt8* buffer, size_t size)
+  // For reading only; the memory is never written unless put*() is called
+  : Serializer(const_cast<uInt8*>(buffer), size)  // NOLINT
+{
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::rewind()
 {
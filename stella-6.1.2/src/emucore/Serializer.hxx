@@ -52,6 +52,15 @@ class Serializer
     Serializer(const string& filename, Mode m = Mode::ReadWrite);
     Serializer();
 
+    /**
+      Creates a new Serializer device on a fixed block of memory, which is
+      read and written in place (e.g. the state buffer of a frontend).
+      Accessing the stream beyond 'size' bytes fails like any other
+      stream error.
+    */
+    Serializer(uInt8* buffer, size_t size);
+    Serializer(const uInt8* buffer, size_t size);
+
   public:
     /**
       Answers whether the serializer is currently initialized for reading
@@ -216,6 +225,9 @@ class Serializer
     void putBool(bool b);
 
   private:
+    // The memory used by the stream, when it is on a fixed block of memory
+    unique_ptr<std::streambuf> myBuffer;
+
     // The stream to send the serialized data to.
     unique_ptr<iostream> myStream;
 
@@ -55,6 +55,7 @@ Settings::Settings()
   setPermanent("tia.fs_stretch", "false");
   setPermanent("tia.fs_overscan", "0");
   setPermanent("tia.dbgcolors", "roygpb");
+  setTemporary("tia.audio", "true");
 
   // TV filtering options
   setPermanent("tv.filter", "0");
@@ -114,6 +115,8 @@ Settings::Settings()
   setPermanent("sssingle", "false");
   setPermanent("ss1x", "false");
   setPermanent("ssinterval", "2");
+  setPermanent("sszlevel", "6");
+  setPermanent("ssindexed", "false");
   setPermanent("autoslot", "false");
   setPermanent("saveonexit", "none");
 
@@ -150,9 +153,13 @@ Settings::Settings()
   setPermanent("logtoconsole", "0");
   setPermanent("avoxport", "");
   setPermanent("fastscbios", "true");
+  setPermanent("idleskip", "true");
+  setPermanent("romwatch", "off");
   setPermanent("threads", "false");
   setTemporary("romloadcount", "0");
   setTemporary("maxres", "");
+  setTemporary("capture", "");
+  setPermanent("captureformat", "y4m");
 
 #ifdef DEBUGGER_SUPPORT
   // Debugger/disassembly options
@@ -337,6 +344,12 @@ void Settings::validate()
   if(i < 1)        setValue("ssinterval", "2");
   else if(i > 10)  setValue("ssinterval", "10");
 
+  i = getInt("sszlevel");
+  if(i < 0 || i > 9)  setValue("sszlevel", "6");
+
+  s = getString("captureformat");
+  if(s != "y4m" && s != "raw")  setValue("captureformat", "y4m");
+
   s = getString("palette");
   if(s != "standard" && s != "z26" && s != "user")
     setValue("palette", "standard");
@@ -413,6 +426,8 @@ void Settings::usage() const
     << "  -tia.fs_overscan <0-10>       Add overscan to TIA image in fullscreen mode\n"
     << "  -tia.dbgcolors   <string>     Debug colors to use for each object (see manual\n"
     << "                                 for description)\n"
+    << "  -tia.audio       <1|0>        Generate TIA audio samples (disable when sound\n"
+    << "                                 is never used, to save time)\n"
     << endl
     << "  -tv.filter    <0-5>           Set TV effects off (0) or to specified mode\n"
     << "                                 (1-5)\n"
@@ -455,6 +470,10 @@ void Settings::usage() const
     << "  -modcombo     <1|0>          Enable modifer key combos\n"
     << "                                (Control-Q for quit may not work when disabled!)\n"
     << "  -fastscbios   <1|0>          Disable Supercharger BIOS progress loading bars\n"
+    << "  -idleskip     <1|0>          Skip over loops which only wait for the timer\n"
+    << "  -romwatch     <off|keep|cpu> Swap a changed ROM file into the running\n"
+    << "                                cartridge, keeping the machine state (or\n"
+    << "                                resetting only the CPU)\n"
     << "  -threads      <1|0>          Whether to using multi-threading during\n"
     << "                                emulation\n"
     << "  -snapsavedir  <path>         The directory to save snapshot files to\n"
@@ -466,6 +485,13 @@ void Settings::usage() const
     << "                                scaling/effects)\n"
     << "  -ssinterval   <number>       Number of seconds between snapshots in\n"
     << "                                continuous snapshot mode\n"
+    << "  -sszlevel     <0-9>          zlib compression level for snapshots (lower\n"
+    << "                                is faster)\n"
+    << "  -ssindexed    <1|0>          Generate 1x mode snapshots as paletted images\n"
+    << "                                taken directly from the TIA\n"
+    << "  -capture      <name>         Record video and audio of the emulation into\n"
+    << "                                <name>.y4m/.raw and <name>.wav\n"
+    << "  -captureformat <y4m|raw>     Video format used for recording\n"
     << endl
     << "  -saveonexit   <none|current| Automatically save state(s) when exiting\n"
     << "                 all>           emulation\n"
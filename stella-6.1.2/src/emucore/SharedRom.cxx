@@ -0,0 +1,76 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <map>
+#include <mutex>
+
+#include "SharedRom.hxx"
+
+namespace {
+  // All shared images, and the lock guarding them (consoles may be
+  // created on several threads)
+  std::map<string, std::weak_ptr<vector<uInt8>>> ourStore;
+  std::mutex ourMutex;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SharedRom::SharedRom(const string& md5, const uInt8* image, size_t size,
+                     size_t capacity, size_t offset)
+{
+  if(!md5.empty())
+  {
+    std::lock_guard<std::mutex> lock(ourMutex);
+
+    myKey = md5 + ":" + std::to_string(capacity) + ":" + std::to_string(offset);
+    myImage = ourStore[myKey].lock();
+    if(!myImage)
+    {
+      myImage = make_shared<vector<uInt8>>(capacity, 0);
+      std::copy_n(image, std::min(size, capacity - offset), myImage->data() + offset);
+      ourStore[myKey] = myImage;
+
+      // Drop the entries of images which are not used anymore
+      for(auto it = ourStore.begin(); it != ourStore.end(); )
+        it = it->second.expired() ? ourStore.erase(it) : std::next(it);
+    }
+  }
+  else
+  {
+    myImage = make_shared<vector<uInt8>>(capacity, 0);
+    std::copy_n(image, std::min(size, capacity - offset), myImage->data() + offset);
+  }
+  myData = myImage->data();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt8* SharedRom::makeUnique()
+{
+  if(!myKey.empty())
+  {
+    std::lock_guard<std::mutex> lock(ourMutex);
+
+    if(myImage.use_count() > 1)
+    {
+      myImage = make_shared<vector<uInt8>>(*myImage);
+      myData = myImage->data();
+    }
+    else
+      ourStore.erase(myKey);  // the image will be changed in place
+    myKey = "";
+  }
+  return myData;
+}
@@ -0,0 +1,76 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef SHARED_ROM_HXX
+#define SHARED_ROM_HXX
+
+#include "bspf.hxx"
+
+/**
+  A read-only ROM image which is shared by all cartridges created from the
+  same ROM (with the same MD5 and layout), so that many instances of the
+  same game keep only one copy of it in memory.
+
+  Images are kept in a store for as long as any cartridge uses them.  A
+  cartridge which needs to change its image (e.g. when patching it in the
+  debugger) first gets a private copy with 'makeUnique()'.
+*/
+class SharedRom
+{
+  public:
+    /**
+      Get the image of the ROM from the store, or add it if necessary.
+
+      @param md5       The MD5 of the ROM (an empty string disables sharing)
+      @param image     The ROM data
+      @param size      The size of the ROM data
+      @param capacity  The size of the image; the ROM data is truncated or
+                       padded with zeros to fit
+      @param offset    Where the ROM data is placed inside the image
+    */
+    SharedRom(const string& md5, const uInt8* image, size_t size,
+              size_t capacity, size_t offset = 0);
+    ~SharedRom() = default;
+
+    const uInt8& operator[](size_t i) const { return myData[i]; }
+    const uInt8* data() const { return myData; }
+    size_t size() const { return myImage->size(); }
+
+    /**
+      Get a writable pointer to the image, copying it first if it is used
+      by any other cartridge.  Note that this may move the image, so all
+      pointers to it must be updated afterwards.
+    */
+    uInt8* makeUnique();
+
+  private:
+    shared_ptr<vector<uInt8>> myImage;
+    uInt8* myData{nullptr};
+
+    // The key of the image in the store ("" when the image isn't stored)
+    string myKey;
+
+  private:
+    // Following constructors and assignment operators not supported
+    SharedRom() = delete;
+    SharedRom(const SharedRom&) = delete;
+    SharedRom(SharedRom&&) = delete;
+    SharedRom& operator=(const SharedRom&) = delete;
+    SharedRom& operator=(SharedRom&&) = delete;
+};
+
+#endif
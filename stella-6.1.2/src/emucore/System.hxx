@@ -260,7 +260,7 @@ class System : public Serializable
         to this page, while other values are the base address of an array
         to directly access for reads to this page.
       */
-      uInt8* directPeekBase{nullptr};
+      const uInt8* directPeekBase{nullptr};
 
       /**
         Pointer to a block of memory or the null pointer.  The null pointer
@@ -125,6 +125,7 @@ void TIASurface::setPalette(const PaletteArray& tia_palette,
                             const PaletteArray& rgb_palette)
 {
   myPalette = tia_palette;
+  myRGBPalette = rgb_palette;
 
   // The NTSC filtering needs access to the raw RGB data, since it calculates
   // its own internal palette
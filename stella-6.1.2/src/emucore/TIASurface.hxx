@@ -67,6 +67,11 @@ class TIASurface
     */
     void setPalette(const PaletteArray& tia_palette, const PaletteArray& rgb_palette);
 
+    /**
+      Get the raw RGB palette (as 0xRRGGBB values) for the current TIA image.
+    */
+    const PaletteArray& rgbPalette() const { return myRGBPalette; }
+
     /**
       Get the TIA base surface for use in saving to a PNG image.
     */
@@ -115,6 +120,12 @@ class TIASurface
     bool ntscEnabled() const { return uInt8(myFilter) & 0x10; }
     string effectsInfo() const;
 
+    /**
+      Answer whether the TIA image is a plain mapping of the TIA frame buffer
+      through the palette (ie, no NTSC filtering or phosphor effects).
+    */
+    bool paletteOnly() const { return myFilter == Filter::Normal; }
+
     /**
       This method should be called to draw the TIA image(s) to the screen.
     */
@@ -180,6 +191,9 @@ class TIASurface
     // Palette for normal TIA rendering mode
     PaletteArray myPalette;
 
+    // Raw RGB data for the above palette
+    PaletteArray myRGBPalette;
+
     // Flag for saving a snapshot
     bool mySaveSnapFlag{false};
 
@@ -22,6 +22,9 @@
 // Code is public domain and used with the author's consent
 //============================================================================
 
+#include <map>
+#include <mutex>
+
 #include "bspf.hxx"
 #include "Base.hxx"
 #include "Cart.hxx"
@@ -52,19 +55,56 @@ using Common::Base;
   #define CONV_RAMROM(d) (d)
 #endif
 
+namespace {
+  // The number of registers in the list of a multiple load/store
+  inline uInt32 registerCount(uInt32 list)
+  {
+    uInt32 count = 0;
+    for(; list; list &= list - 1)
+      ++count;
+    return count;
+  }
+
+  // The ARM7TDMI multiplier finishes early for small multiplicands
+  inline uInt32 multiplyCycles(uInt32 rs)
+  {
+    if((rs & 0xFFFFFF00) == 0 || (rs & 0xFFFFFF00) == 0xFFFFFF00)  return 1;
+    if((rs & 0xFFFF0000) == 0 || (rs & 0xFFFF0000) == 0xFFFF0000)  return 2;
+    if((rs & 0xFF000000) == 0 || (rs & 0xFF000000) == 0xFF000000)  return 3;
+    return 4;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const std::array<uInt8, uInt32(Thumbulator::Op::uxth) + 1> Thumbulator::ourOpCycles = [] {
+  std::array<uInt8, uInt32(Op::uxth) + 1> cycles;
+  cycles.fill(1);
+
+  // Loads take 1S + 1N + 1I, stores 2N
+  for(Op op: { Op::ldr1, Op::ldr2, Op::ldr3, Op::ldr4, Op::ldrb1, Op::ldrb2,
+               Op::ldrh1, Op::ldrh2, Op::ldrsb, Op::ldrsh })
+    cycles[uInt32(op)] = 3;
+  for(Op op: { Op::str1, Op::str2, Op::str3, Op::strb1, Op::strb2,
+               Op::strh1, Op::strh2 })
+    cycles[uInt32(op)] = 2;
+  // Plus one cycle per register
+  cycles[uInt32(Op::ldmia)] = cycles[uInt32(Op::pop)] = 2;
+  cycles[uInt32(Op::swi)] = 3;
+
+  return cycles;
+}();
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, uInt16 rom_size,
                          bool traponfatal, Thumbulator::ConfigureFor configurefor,
                          Cartridge* cartridge)
   : rom(rom_ptr),
     romSize(rom_size),
-    decodedRom(make_unique<Op[]>(romSize / 2)),  // NOLINT
     ram(ram_ptr),
     configuration(configurefor),
     myCartridge(cartridge)
 {
-  for(uInt16 i = 0; i < romSize / 2; ++i)
-    decodedRom[i] = decodeInstructionWord(CONV_RAMROM(rom[i]));
+  setRom(rom_ptr);
 
   setConsoleTiming(ConsoleTiming::ntsc);
 #ifndef UNSAFE_OPTIMIZATIONS
@@ -74,24 +114,76 @@ Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, uInt16 rom_size
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-string Thumbulator::run()
+void Thumbulator::setRom(const uInt16* rom_ptr)
 {
-  reset();
-  for(;;)
+  rom = rom_ptr;
+  decodedTable = decodeRom(rom, romSize);
+  decodedRom = decodedTable->data();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+shared_ptr<const vector<Thumbulator::Op>>
+Thumbulator::decodeRom(const uInt16* rom_ptr, uInt16 rom_size)
+{
+  // A ROM can only be freed after all instances running it, so its address
+  // identifies the table as long as that is in use
+  static std::map<const uInt16*, std::weak_ptr<const vector<Op>>> decoded;
+  static std::mutex mutex;
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  shared_ptr<const vector<Op>> table = decoded[rom_ptr].lock();
+  if(!table || table->size() != rom_size / 2u)
   {
-    if(execute()) break;
+    auto ops = make_shared<vector<Op>>(rom_size / 2);
+    for(uInt16 i = 0; i < rom_size / 2; ++i)
+      (*ops)[i] = decodeInstructionWord(CONV_RAMROM(rom_ptr[i]));
+
+    table = ops;
+    decoded[rom_ptr] = table;
+
+    for(auto it = decoded.begin(); it != decoded.end(); )
+      it = it->second.expired() ? decoded.erase(it) : std::next(it);
+  }
+  return table;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Thumbulator::Status Thumbulator::call(uInt32 cycles)
+{
+  updateTimer(cycles);
+  resetRegisters();
+  armCycles = 0;
 #ifndef UNSAFE_OPTIMIZATIONS
-    if(instructions > 500000) // way more than would otherwise be possible
-      throw runtime_error("instructions > 500000");
+  // Only needed when errors are logged or debugging output is created
+  if(statusMsg.tellp() > 0)
+    statusMsg.str("");
 #endif
+#if defined(THUMB_DISS) || defined(THUMB_DBUG)
+  instructions = 0;
+  fetches = reads = writes = 0;
+#endif
+
+  Status status = Status::aborted;
+  for(uInt32 count = 0; count < MAX_INSTRUCTIONS; ++count)
+  {
+    const uInt32 pc = reg_norm[15];
+
+    if(execute())
+    {
+      status = Status::returned;
+      break;
+    }
+    // Taken branches refill the pipeline (2 more cycles)
+    if(reg_norm[15] != pc + 2)
+      armCycles += 2;
   }
 #if defined(THUMB_DISS) || defined(THUMB_DBUG)
   dump_counters();
   cout << statusMsg.str() << endl;
-  return statusMsg.str();
-#else
-  return "";
 #endif
+
+  return status;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -118,13 +210,6 @@ void Thumbulator::updateTimer(uInt32 cycles)
     T1TC += uInt32(cycles * timing_factor);
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-string Thumbulator::run(uInt32 cycles)
-{
-  updateTimer(cycles);
-  return run();
-}
-
 #ifndef UNSAFE_OPTIMIZATIONS
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 inline int Thumbulator::fatalError(const char* opcode, uInt32 v1, const char* msg)
@@ -831,6 +916,7 @@ int Thumbulator::execute()
 #else
   decodedOp = decodedRom[(instructionPtr & ROMADDMASK) >> 1];
 #endif
+  armCycles += ourOpCycles[uInt32(decodedOp)];
 
   switch (decodedOp) {
     //ADC
@@ -1621,6 +1707,7 @@ int Thumbulator::execute()
       }
       statusMsg << "}" << endl;
     #endif
+      armCycles += registerCount(inst & 0xFF);
       sp = read_register(rn);
       for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ++ra)
       {
@@ -1964,6 +2051,7 @@ int Thumbulator::execute()
       ra = read_register(rd);
       rb = read_register(rm);
       rc = ra * rb;
+      armCycles += multiplyCycles(ra);
       write_register(rd, rc);
       do_nflag(rc);
       do_zflag(rc);
@@ -2033,6 +2121,7 @@ int Thumbulator::execute()
       statusMsg << "}" << endl;
     #endif
 
+      armCycles += registerCount(inst & 0x1FF);
       sp = read_register(13);
       for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ++ra)
       {
@@ -2074,6 +2163,7 @@ int Thumbulator::execute()
       statusMsg << "}" << endl;
     #endif
 
+      armCycles += registerCount(inst & 0x1FF);
       sp = read_register(13);
       //fprintf(stderr,"sp 0x%08X\n",sp);
       for(ra = 0, rb = 0x01, rc = 0; rb; rb = (rb << 1) & 0xFF, ++ra)
@@ -2232,6 +2322,7 @@ int Thumbulator::execute()
       statusMsg << "}" << endl;
     #endif
 
+      armCycles += registerCount(inst & 0xFF);
       sp = read_register(rn);
       for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ++ra)
       {
@@ -2518,6 +2609,29 @@ int Thumbulator::execute()
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 int Thumbulator::reset()
+{
+  resetRegisters();
+  mamcr = 0;
+
+  systick_ctrl = 0x00000004;
+  systick_reload = 0x00000000;
+  systick_count = 0x00000000;
+  systick_calibrate = 0x00ABCDEF;
+
+  // fxq: don't care about below so much (maybe to guess timing???)
+#ifndef UNSAFE_OPTIMIZATIONS
+  instructions = 0;
+  statusMsg.str("");
+#endif
+#ifndef NO_THUMB_STATS
+  fetches = reads = writes = 0;
+#endif
+
+  return 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::resetRegisters()
 {
   reg_norm.fill(0);
   reg_norm[13] = 0x40001FB4;
@@ -2540,24 +2654,8 @@ int Thumbulator::reset()
       break;
   }
 
-  cpsr = mamcr = 0;
+  cpsr = 0;
   handler_mode = false;
-
-  systick_ctrl = 0x00000004;
-  systick_reload = 0x00000000;
-  systick_count = 0x00000000;
-  systick_calibrate = 0x00ABCDEF;
-
-  // fxq: don't care about below so much (maybe to guess timing???)
-#ifndef UNSAFE_OPTIMIZATIONS
-  instructions = 0;
-  statusMsg.str("");
-#endif
-#ifndef NO_THUMB_STATS
-  fetches = reads = writes = 0;
-#endif
-
-  return 0;
 }
 
 #ifndef UNSAFE_OPTIMIZATIONS
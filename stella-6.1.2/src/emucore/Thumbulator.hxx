@@ -63,16 +63,30 @@ class Thumbulator
                 bool traponfatal, Thumbulator::ConfigureFor configurefor,
                 Cartridge* cartridge);
 
+    // The result of calling the ARM code with 'call()'
+    enum class Status : uInt8 {
+      returned,  // the code returned to the driver
+      aborted    // the code didn't return within MAX_INSTRUCTIONS
+    };
+
     /**
-      Run the ARM code, and return when finished.  A runtime_error exception is
-      thrown in case of any fatal errors/aborts (if enabled), containing the
-      actual error, and the contents of the registers at that point in time.
+      Run the ARM code for a cartridge driver call, and return when finished.
+      Only the core registers are reset; the peripherals, decoded ROM and
+      memory keep their state between calls.  A runtime_error exception is
+      thrown in case of any fatal errors (if enabled), containing the actual
+      error, and the contents of the registers at that point in time.
+      Debugging output (if enabled) is written to the console.
+
+      @param cycles  The 6507 cycles passed since the previous call
+      @return  Whether the code returned or was aborted
+    */
+    Status call(uInt32 cycles);
 
-      @return  The results of any debugging output (if enabled),
-               otherwise an empty string
+    /**
+      An estimate of the ARM cycles used by the last 'call()', based on the
+      ARM7TDMI timings of the executed instructions (without wait states).
     */
-    string run();
-    string run(uInt32 cycles);
+    uInt64 lastCallCycles() const { return armCycles; }
 
 #ifndef UNSAFE_OPTIMIZATIONS
     /**
@@ -97,6 +111,12 @@ class Thumbulator
     */
     void setConsoleTiming(ConsoleTiming timing);
 
+    /**
+      Switch to another copy of the ROM (of the same size), for when the
+      cartridge moved its image.
+    */
+    void setRom(const uInt16* rom_ptr);
+
   private:
 
     enum class Op : uInt8 {
@@ -164,6 +184,10 @@ class Thumbulator
 
     static Op decodeInstructionWord(uint16_t inst);
 
+    // Get the decoded instructions of the ROM; these are shared by all
+    // instances which run the same copy of the ROM
+    static shared_ptr<const vector<Op>> decodeRom(const uInt16* rom_ptr, uInt16 rom_size);
+
     void do_zflag(uInt32 x);
     void do_nflag(uInt32 x);
     void do_cflag(uInt32 a, uInt32 b, uInt32 c);
@@ -183,11 +207,17 @@ class Thumbulator
 #endif
     int execute();
     int reset();
+    void resetRegisters();
+
+    // Upper limit for the instructions of a single call, way more than
+    // would otherwise be possible
+    static constexpr uInt32 MAX_INSTRUCTIONS = 500000;
 
   private:
     const uInt16* rom{nullptr};
     uInt16 romSize{0};
-    const unique_ptr<Op[]> decodedRom;  // NOLINT
+    shared_ptr<const vector<Op>> decodedTable;
+    const Op* decodedRom{nullptr};
     uInt16* ram{nullptr};
 
     std::array<uInt32, 16> reg_norm; // normal execution mode, do not have a thread mode
@@ -200,6 +230,12 @@ class Thumbulator
 #ifndef NO_THUMB_STATS
     uInt64 fetches{0}, reads{0}, writes{0};
 #endif
+    uInt64 armCycles{0};
+
+    // ARM7TDMI cycles of each instruction, not including the transferred
+    // registers of multiple loads/stores, the multiplier and the pipeline
+    // refill of taken branches
+    static const std::array<uInt8, uInt32(Op::uxth) + 1> ourOpCycles;
 
     // For emulation of LPC2103's timer 1, used for NTSC/PAL/SECAM detection.
     // Register names from documentation:
@@ -0,0 +1,358 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <atomic>
+#include <thread>
+
+#include "TimingVerifier.hxx"
+#include "FSNode.hxx"
+#include "CartDetector.hxx"
+#include "Cart.hxx"
+#include "MD5.hxx"
+#include "Control.hxx"
+#include "M6502.hxx"
+#include "M6532.hxx"
+#include "TIA.hxx"
+#include "TIAConstants.hxx"
+#include "ConsoleTiming.hxx"
+#include "FrameManager.hxx"
+#include "FrameLayoutDetector.hxx"
+#include "System.hxx"
+#include "Joystick.hxx"
+#include "Random.hxx"
+#include "DispatchResult.hxx"
+#include "Logger.hxx"
+#include "Settings.hxx"
+#include "Props.hxx"
+#include "PropsSet.hxx"
+
+namespace {
+  constexpr uInt32 FRAMES_DEFAULT = 300;
+
+  // Frames emulated for the frame layout detection, and skipped after
+  // the reset before measuring (the kernel may still be initializing)
+  constexpr uInt32 DETECTION_FRAMES = 60;
+  constexpr uInt32 WARMUP_FRAMES = TIAConstants::initialGarbageFrames;
+
+  // The distance (in scanlines) of a WSYNC from the previous one when it
+  // was overrun: the code after the previous WSYNC took more than one
+  // line, so the CPU was released one line later than intended.  Larger
+  // distances can't be told apart from intended waits (e.g. for the RIOT
+  // timer during VBLANK and overscan), so they aren't reported.
+  constexpr uInt64 OVERRUN_DISTANCE = 2;
+
+  string jsonString(const string& s)
+  {
+    ostringstream buf;
+
+    buf << '"';
+    for(char c: s)
+    {
+      if(c == '"' || c == '\\')
+        buf << '\\' << c;
+      else if(uInt8(c) < 0x20)
+        buf << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c)
+            << std::dec;
+      else
+        buf << c;
+    }
+    buf << '"';
+
+    return buf.str();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TimingVerifier::TimingVerifier(int argc, char* argv[])
+{
+  uInt32 frames = FRAMES_DEFAULT;
+
+  for(int i = 2; i < argc; ++i)
+  {
+    const string arg = argv[i];
+
+    if(arg == "-frames" && i + 1 < argc)
+    {
+      const int value = BSPF::stringToInt(argv[++i]);
+      if(value > 0)
+        frames = value;
+      continue;
+    }
+    if(arg == "-threads" && i + 1 < argc)
+    {
+      myThreads = std::max(BSPF::stringToInt(argv[++i]), 0);
+      continue;
+    }
+
+    // A ROM, optionally followed by ':' and its number of frames
+    VerifyRun run;
+    const size_t splitPoint = arg.find_last_of(':');
+    const string suffix = splitPoint == string::npos ? "" : arg.substr(splitPoint + 1);
+
+    if(!suffix.empty() && BSPF::stringToInt(suffix) > 0)
+    {
+      run.romFile = arg.substr(0, splitPoint);
+      run.frames = BSPF::stringToInt(suffix);
+    }
+    else
+      run.romFile = arg;
+
+    myRuns.push_back(run);
+  }
+
+  for(VerifyRun& run: myRuns)
+    if(run.frames == 0)
+      run.frames = frames;
+
+  if(myThreads == 0)
+    myThreads = std::max(std::thread::hardware_concurrency(), 1U);
+  myThreads = std::min(myThreads, uInt32(myRuns.size()));
+
+  // Only errors may go to the console, the results are written there
+  Logger::instance().setLogParameters(Logger::Level::ERR, false);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TimingVerifier::run()
+{
+  vector<Result> results(myRuns.size());
+  std::atomic<size_t> next{0};
+
+  const auto worker = [&]() {
+    for(size_t i = next++; i < myRuns.size(); i = next++)
+    {
+      try
+      {
+        verifyOne(myRuns[i], results[i]);
+      }
+      catch(const std::exception& e)
+      {
+        results[i].error = e.what();
+      }
+    }
+  };
+
+  vector<std::thread> threads;
+  for(uInt32 i = 1; i < myThreads; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for(auto& thread: threads)
+    thread.join();
+
+  bool passed = true;
+  for(size_t i = 0; i < myRuns.size(); ++i)
+  {
+    printResult(cout, myRuns[i], results[i]);
+    passed = passed && results[i].passed();
+  }
+  cout.flush();
+
+  return passed;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TimingVerifier::verifyOne(const VerifyRun& run, Result& result)
+{
+  FilesystemNode imageFile(run.romFile);
+
+  if(!imageFile.isFile())
+  {
+    result.error = "not a ROM image";
+    return;
+  }
+
+  ByteBuffer image;
+  size_t size = imageFile.read(image);
+  if(size == 0)
+  {
+    result.error = "unable to read ROM image";
+    return;
+  }
+
+  // Settings aren't thread-safe, so each run gets its own
+  Settings settings;
+  settings.setValue("fastscbios", true);
+  settings.setValue("tia.audio", false);
+
+  // The display format may be configured in the ROM properties
+  string md5 = MD5::hash(image, size);
+  Properties props;
+  PropertiesSet().getMD5(md5, props);
+  unique_ptr<Cartridge> cartridge =
+      CartDetector::create(imageFile, image, size, md5, "", settings);
+
+  if(!cartridge)
+  {
+    result.error = "unable to determine cartridge type";
+    return;
+  }
+
+  IO consoleIO;
+  Random rng(0);
+  Event event;
+
+  ConsoleTiming consoleTiming = ConsoleTiming::ntsc;
+  M6502 cpu(settings);
+  M6532 riot(consoleIO, settings);
+  TIA tia(consoleIO, [&consoleTiming]() { return consoleTiming; }, settings);
+  System system(rng, cpu, riot, tia, *cartridge);
+
+  consoleIO.myLeftControl = make_unique<Joystick>(Controller::Jack::Left, event, system);
+  consoleIO.myRightControl = make_unique<Joystick>(Controller::Jack::Right, event, system);
+  consoleIO.mySwitches = make_unique<Switches>(event, props, settings);
+
+  tia.bindToControllers();
+  cartridge->setStartBankFromPropsFunc([]() { return -1; });
+  system.initialize();
+
+  // Use the configured display format, or detect the frame layout
+  result.layout = props.get(PropType::Display_Format);
+  if(result.layout != "NTSC" && result.layout != "PAL" &&
+     result.layout != "SECAM" && result.layout != "NTSC50" &&
+     result.layout != "PAL60" && result.layout != "SECAM60")
+  {
+    FrameLayoutDetector frameLayoutDetector;
+    tia.setFrameManager(&frameLayoutDetector);
+    system.reset();
+
+    for(uInt32 i = 0; i < DETECTION_FRAMES; ++i)
+      tia.update();
+
+    result.layout =
+      frameLayoutDetector.detectedLayout() == FrameLayout::pal ? "PAL" : "NTSC";
+  }
+
+  // Same as in Console::setConsoleTiming() and Console::setTIAProperties()
+  if(result.layout == "PAL" || result.layout == "PAL60")
+    consoleTiming = ConsoleTiming::pal;
+  else if(result.layout == "SECAM" || result.layout == "SECAM60")
+    consoleTiming = ConsoleTiming::secam;
+
+  const FrameLayout frameLayout = result.layout == "NTSC" ||
+    result.layout == "PAL60" || result.layout == "SECAM60"
+    ? FrameLayout::ntsc : FrameLayout::pal;
+  result.expectedLines = frameLayout == FrameLayout::pal
+    ? FrameManager::frameSizePAL : FrameManager::frameSizeNTSC;
+
+  FrameManager frameManager;
+  tia.setFrameManager(&frameManager);
+  tia.setLayout(frameLayout);
+  system.consoleChanged(consoleTiming);
+
+  system.reset();
+
+  // Scanlines are counted across frames, since a kernel can overrun
+  // a WSYNC right at the start of a frame
+  uInt64 linesBeforeFrame = 0, lastWsyncLine = 0, vsyncStartLine = 0;
+  bool vsync = false, vsyncEnded = false, measuring = false;
+
+  const auto currentLine = [&]() { return linesBeforeFrame + tia.scanlines(); };
+
+  tia.setSyncCallback([&](uInt8 address, uInt8 value) {
+    const uInt64 line = currentLine();
+
+    if(address == WSYNC)
+    {
+      // The CPU resumed at the start of the line after the previous WSYNC
+      if(measuring && lastWsyncLine > 0 && line == lastWsyncLine + OVERRUN_DISTANCE)
+      {
+        ++result.overruns;
+        ++result.overrunsPerLine[tia.scanlines()];
+      }
+      lastWsyncLine = line;
+    }
+    else if(bool(value & 0x02) != vsync)
+    {
+      vsync = !vsync;
+      if(vsync)
+        vsyncStartLine = line;
+      else
+      {
+        const uInt32 vsyncLines = uInt32(line - vsyncStartLine);
+        if(measuring)
+        {
+          result.minVsyncLines = std::min(result.minVsyncLines, vsyncLines);
+          result.maxVsyncLines = std::max(result.maxVsyncLines, vsyncLines);
+        }
+        vsyncEnded = true;
+      }
+    }
+  });
+
+  tia.setFrameCallback([&](const uInt8*) {
+    const uInt32 lines = tia.scanlinesLastFrame();
+
+    linesBeforeFrame += lines;
+    if(measuring)
+    {
+      ++result.frames;
+      result.minLines = std::min(result.minLines, lines);
+      result.maxLines = std::max(result.maxLines, lines);
+      if(lines != result.expectedLines)
+        ++result.badFrames;
+      if(!vsyncEnded)
+        ++result.missingVsyncs;
+    }
+    vsyncEnded = false;
+    measuring = tia.frameCount() >= WARMUP_FRAMES;
+  });
+
+  DispatchResult dispatchResult;
+  dispatchResult.setOk(0);
+
+  while(result.frames < run.frames &&
+        dispatchResult.getStatus() == DispatchResult::Status::ok)
+    tia.update(dispatchResult);
+
+  if(dispatchResult.getStatus() != DispatchResult::Status::ok)
+    result.error = "emulation failed after " + std::to_string(result.frames) + " frames";
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TimingVerifier::printResult(ostream& out, const VerifyRun& run,
+                                 const Result& result)
+{
+  out << "{\"rom\":" << jsonString(run.romFile);
+
+  if(!result.error.empty())
+  {
+    out << ",\"result\":\"error\",\"message\":" << jsonString(result.error) << "}\n";
+    return;
+  }
+
+  const bool vsyncs = result.minVsyncLines <= result.maxVsyncLines;
+
+  out << ",\"result\":\"" << (result.passed() ? "pass" : "fail") << "\""
+      << ",\"layout\":\"" << result.layout << "\""
+      << ",\"frames\":" << result.frames
+      << ",\"scanlines\":{\"expected\":" << result.expectedLines
+      << ",\"min\":" << (result.frames ? result.minLines : 0)
+      << ",\"max\":" << result.maxLines
+      << ",\"bad_frames\":" << result.badFrames << "}"
+      << ",\"vsync\":{\"missing\":" << result.missingVsyncs
+      << ",\"min_lines\":" << (vsyncs ? result.minVsyncLines : 0)
+      << ",\"max_lines\":" << result.maxVsyncLines << "}"
+      << ",\"wsync_overruns\":{\"total\":" << result.overruns << ",\"scanlines\":{";
+
+  const char* separator = "";
+  for(const auto& line: result.overrunsPerLine)
+  {
+    out << separator << "\"" << line.first << "\":" << line.second;
+    separator = ",";
+  }
+  out << "}}}\n";
+}
@@ -0,0 +1,107 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef TIMING_VERIFIER_HXX
+#define TIMING_VERIFIER_HXX
+
+class Controller;
+class Switches;
+
+#include <map>
+
+#include "bspf.hxx"
+#include "ConsoleIO.hxx"
+
+/**
+  Runs ROMs headless for a number of frames, in parallel, and checks the
+  timing of their kernels:
+
+  - each frame must have the number of scanlines of its frame layout
+    (262 for NTSC, 312 for PAL), according to the display format in the
+    ROM properties, or the detected one
+  - each frame must be ended by VSYNC
+  - no WSYNC may be overrun, ie. strobed one scanline too late because the
+    code since the previous WSYNC needed more than a full scanline
+
+  The results are written to stdout, one JSON object per ROM and line.
+*/
+class TimingVerifier
+{
+  public:
+    TimingVerifier(int argc, char* argv[]);
+
+    /**
+      Verify all ROMs and print the results.
+
+      @return  True if all ROMs passed
+    */
+    bool run();
+
+  private:
+    struct VerifyRun {
+      string romFile;
+      uInt32 frames{0};
+    };
+
+    struct Result {
+      string error;               // the ROM couldn't be run if not empty
+      string layout;
+      uInt32 expectedLines{0};
+      uInt32 frames{0};
+      uInt32 minLines{~0U}, maxLines{0};
+      uInt32 badFrames{0};        // frames with an unexpected number of lines
+      uInt32 missingVsyncs{0};    // frames which ended without VSYNC
+      uInt32 minVsyncLines{~0U}, maxVsyncLines{0};
+      uInt32 overruns{0};
+      std::map<uInt32, uInt32> overrunsPerLine;
+
+      bool passed() const {
+        return error.empty() && badFrames == 0 && missingVsyncs == 0 && overruns == 0;
+      }
+    };
+
+    struct IO: public ConsoleIO {
+      Controller& leftController() const override { return *myLeftControl; }
+      Controller& rightController() const override { return *myRightControl; }
+      Switches& switches() const override { return *mySwitches; }
+
+      unique_ptr<Controller> myLeftControl;
+      unique_ptr<Controller> myRightControl;
+      unique_ptr<Switches> mySwitches;
+    };
+
+  private:
+    // Run a single ROM; this is called from several threads at once
+    static void verifyOne(const VerifyRun& run, Result& result);
+
+    static void printResult(ostream& out, const VerifyRun& run,
+                            const Result& result);
+
+  private:
+    vector<VerifyRun> myRuns;
+    uInt32 myThreads{0};
+
+  private:
+    // Following constructors and assignment operators not supported
+    TimingVerifier() = delete;
+    TimingVerifier(const TimingVerifier&) = delete;
+    TimingVerifier(TimingVerifier&&) = delete;
+    TimingVerifier& operator=(const TimingVerifier&) = delete;
+    TimingVerifier& operator=(TimingVerifier&&) = delete;
+};
+
+#endif
@@ -54,6 +54,7 @@ MODULE_OBJS := \
 	src/emucore/Console.o \
 	src/emucore/Control.o \
 	src/emucore/ControllerDetector.o \
+	src/emucore/DetectionCache.o \
 	src/emucore/DispatchResult.o \
 	src/emucore/Driving.o \
 	src/emucore/EventHandler.o \
@@ -63,6 +64,7 @@ MODULE_OBJS := \
 	src/emucore/FBSurface.o \
 	src/emucore/FSNode.o \
 	src/emucore/Genesis.o \
+	src/emucore/InstructionTrace.o \
 	src/emucore/Joystick.o \
 	src/emucore/Keyboard.o \
 	src/emucore/KidVid.o \
@@ -81,10 +83,12 @@ MODULE_OBJS := \
 	src/emucore/SaveKey.o \
 	src/emucore/Serializer.o \
 	src/emucore/Settings.o \
+	src/emucore/SharedRom.o \
 	src/emucore/Switches.o \
 	src/emucore/System.o \
 	src/emucore/TIASurface.o \
-	src/emucore/Thumbulator.o
+	src/emucore/Thumbulator.o \
+	src/emucore/TimingVerifier.o
 
 MODULE_DIRS += \
 	src/emucore
@@ -61,23 +61,51 @@ void Audio::setAudioQueue(const shared_ptr<AudioQueue>& queue)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Audio::tick()
+void Audio::enable(bool enabled)
 {
-  switch (myCounter) {
-    case 9:
-    case 81:
-      myChannel0.phase0();
-      myChannel1.phase0();
+  myIsEnabled = enabled;
+}
 
-      break;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Audio::tick(uInt32 colorClocks)
+{
+  if (!myIsEnabled) {
+    myCounter = (myCounter + colorClocks) % 228;
+    return;
+  }
+
+  uInt32 counter = myCounter;
 
-    case 37:
-    case 149:
-      phase1();
+  // Jump from one phase clock to the next instead of stepping through every color clock
+  while (true) {
+    const uInt32 next =
+      counter <= 9 ? 9 : counter <= 37 ? 37 : counter <= 81 ? 81 : counter <= 149 ? 149 : 228 + 9;
+
+    if (next - counter >= colorClocks) {
+      counter += colorClocks;
       break;
+    }
+
+    colorClocks -= next - counter + 1;
+    counter = next + 1;
+
+    switch (next) {
+      case 9:
+      case 81:
+      case 228 + 9:
+        myChannel0.phase0();
+        myChannel1.phase0();
+        break;
+
+      default:
+        phase1();
+        break;
+    }
+
+    if (counter >= 228) counter -= 228;
   }
 
-  if (++myCounter == 228) myCounter = 0;
+  myCounter = counter >= 228 ? counter - 228 : counter;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
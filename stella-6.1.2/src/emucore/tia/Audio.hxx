@@ -33,7 +33,18 @@ class Audio : public Serializable
 
     void setAudioQueue(const shared_ptr<AudioQueue>& queue);
 
-    void tick();
+    /**
+      Enable/disable sample generation. While disabled, only the register
+      values and the clock phase are kept up to date.
+     */
+    void enable(bool enabled);
+
+    /**
+      Advance audio emulation by the given number of color clocks. The clocks
+      in between the two audio phases are skipped in one go, so this should be
+      called once per run of clocks (at the latest before writing to AUDx).
+     */
+    void tick(uInt32 colorClocks);
 
     AudioChannel& channel0();
 
@@ -52,6 +63,7 @@ class Audio : public Serializable
     shared_ptr<AudioQueue> myAudioQueue;
 
     uInt8 myCounter{0};
+    bool myIsEnabled{true};
 
     AudioChannel myChannel0;
     AudioChannel myChannel1;
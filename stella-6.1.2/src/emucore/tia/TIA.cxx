@@ -180,6 +180,7 @@ void TIA::initialize()
   myFramebuffer.fill(0);
 
   applyDeveloperSettings();
+  enableAudio(mySettings.getBool("tia.audio"));
 
   // Must be done last, after all other items have reset
   bool devSettings = mySettings.getBool("dev.settings");
@@ -508,6 +509,7 @@ bool TIA::poke(uInt16 address, uInt8 value)
   switch (address)
   {
     case WSYNC:
+      if (mySyncCallback) mySyncCallback(address, value);
       mySystem->m6502().requestHalt();
       break;
 
@@ -518,6 +520,7 @@ bool TIA::poke(uInt16 address, uInt8 value)
       break;
 
     case VSYNC:
+      if (mySyncCallback) mySyncCallback(address, value);
       myFrameManager->setVsync(value & 0x02);
       myShadowRegisters[address] = value;
       break;
@@ -1254,6 +1257,8 @@ void TIA::onFrameComplete()
   myFrontBufferScanlines = scanlinesLastFrame();
 
   ++myFramesSinceLastRender;
+
+  if (myFrameCallback) myFrameCallback(myFrontBuffer.data());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1290,12 +1295,14 @@ void TIA::cycle(uInt32 colorClocks)
     if (++myHctr >= TIAConstants::H_CLOCKS)
       nextLine();
 
-    #ifdef SOUND_SUPPORT
-      myAudio.tick();
-    #endif
-
     ++myTimestamp;
   }
+
+  // Audio is independent of the other TIA state, so all clocks since the last
+  // TIA access (including any AUDx write) are run in one batch
+  #ifdef SOUND_SUPPORT
+    myAudio.tick(colorClocks);
+  #endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -104,6 +104,8 @@ class TIA : public Device
     };
 
     using ConsoleTimingProvider = std::function<ConsoleTiming()>;
+    using FrameCallback = std::function<void(const uInt8* frameBuffer)>;
+    using SyncCallback = std::function<void(uInt8 address, uInt8 value)>;
 
   public:
     friend class TIADebug;
@@ -131,6 +133,27 @@ class TIA : public Device
     */
     void setAudioQueue(const shared_ptr<AudioQueue>& audioQueue);
 
+    /**
+      Enable/disable generation of audio samples (see Audio::enable).
+    */
+    void enableAudio(bool enabled) { myAudio.enable(enabled); }
+
+    /**
+      Set a callback which receives every completed frame (in the same
+      format as the frame buffer), directly from the emulation.
+
+      @param callback  The callback, or nullptr to remove it
+    */
+    void setFrameCallback(const FrameCallback& callback) { myFrameCallback = callback; }
+
+    /**
+      Set a callback which is invoked on every write to VSYNC or WSYNC,
+      before the write takes effect (used for verifying kernel timing).
+
+      @param callback  The callback, or nullptr to remove it
+    */
+    void setSyncCallback(const SyncCallback& callback) { mySyncCallback = callback; }
+
     /**
       Clear the configured frame manager and deteach the lifecycle callbacks.
      */
@@ -700,6 +723,16 @@ class TIA : public Device
     ConsoleTimingProvider myTimingProvider;
     Settings& mySettings;
 
+    /**
+     * Receives all completed frames (used for capturing)
+     */
+    FrameCallback myFrameCallback;
+
+    /**
+     * Receives all writes to VSYNC and WSYNC
+     */
+    SyncCallback mySyncCallback;
+
     /**
      * The length of the delay queue (maximum number of clocks delay)
      */
@@ -24,6 +24,9 @@
 /**
  * This frame manager performs frame layout autodetection. It counts the scanlines
  * in each frame and assigns guesses the frame layout from this.
+ *
+ * Detection results are cached per ROM, so changes that alter them require
+ * bumping DetectionCache::DETECTION_VERSION.
  */
 class FrameLayoutDetector: public AbstractFrameManager {
   public:
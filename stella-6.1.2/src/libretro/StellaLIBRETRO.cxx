@@ -43,10 +43,13 @@ StellaLIBRETRO::StellaLIBRETRO()
   video_palette = "standard";
   video_filter = NTSCFilter::Preset::OFF;
   video_ready = false;
+  video_pending = false;
 
   audio_samples = 0;
   audio_mode = "byrom";
 
+  state_size = 0;
+
   video_phosphor = "byrom";
   video_phosphor_blend = 60;
   phosphor_default = false;
@@ -128,7 +131,9 @@ bool StellaLIBRETRO::create(bool logging)
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
   video_ready = false;
+  video_pending = false;
   audio_samples = 0;
+  state_size = 0;
 
   system_ready = true;
   return true;
@@ -148,10 +153,6 @@ void StellaLIBRETRO::destroy()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void StellaLIBRETRO::runFrame()
 {
-  // write ram updates
-  for(int lcv = 0; lcv <= 127; lcv++)
-    myOSystem->console().system().m6532().poke(lcv | 0x80, system_ram[lcv]);
-
   // poll input right at vsync
   updateInput();
 
@@ -160,9 +161,6 @@ void StellaLIBRETRO::runFrame()
 
   // drain generated audio
   updateAudio();
-
-  // refresh ram copy
-  memcpy(system_ram, myOSystem->console().system().m6532().getRAM(), 128);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -181,22 +179,22 @@ void StellaLIBRETRO::updateVideo()
 {
   TIA& tia = myOSystem->console().tia();
 
-  while (1)
-  {
-    tia.updateScanline();
-
-    if(tia.scanlines() == 0) break;
-  }
-
+  // Run the whole frame in a single dispatch; the CPU is stopped as soon
+  // as the frame manager completes the frame
+  tia.update();
 
   video_ready = tia.newFramePending();
 
   if (video_ready)
   {
-    FrameBuffer& frame = myOSystem->frameBuffer();
-
     tia.renderToFrameBuffer();
-    frame.updateInEmulationMode(0);
+
+    // Without TV effects, mapping the frame through the palette is deferred
+    // until the frontend asks for it, so it can go directly into its buffer
+    video_pending = getVideoIndexed();
+
+    if (!video_pending)
+      myOSystem->frameBuffer().updateInEmulationMode(0);
   }
 }
 
@@ -209,41 +207,44 @@ void StellaLIBRETRO::updateAudio()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool StellaLIBRETRO::loadState(const void* data, size_t size)
 {
-  Serializer state;
-
-  state.putByteArray(reinterpret_cast<const uInt8*>(data), static_cast<uInt32>(size));
-
-  if(!myOSystem->state().loadState(state))
-    return false;
+  // Read the state directly from the frontend's buffer
+  Serializer state(reinterpret_cast<const uInt8*>(data), size);
 
-  memcpy(system_ram, myOSystem->console().system().m6532().getRAM(), 128);
-  return true;
+  return myOSystem->state().loadState(state);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool StellaLIBRETRO::saveState(void* data, size_t size)
 {
-  Serializer state;
+  // Write the state directly into the frontend's buffer
+  Serializer state(reinterpret_cast<uInt8*>(data), size);
 
-  if (!myOSystem->state().saveState(state))
-    return false;
+  return myOSystem->state().saveState(state);
+}
 
-  if (state.size() > size)
-    return false;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt8* StellaLIBRETRO::getRAM()
+{
+  // The frontend reads and writes the RIOT RAM in place
+  if(!myOSystem || !myOSystem->hasConsole())
+    return nullptr;
 
-  state.getByteArray(reinterpret_cast<uInt8*>(data), static_cast<uInt32>(state.size()));
-  return true;
+  return myOSystem->console().system().m6532().getRAM();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 size_t StellaLIBRETRO::getStateSize()
 {
-  Serializer state;
-
-  if (!myOSystem->state().saveState(state))
-    return 0;
+  // The layout of the state is fixed for a given console, so its size only
+  // has to be measured once
+  if (state_size == 0)
+  {
+    Serializer state;
 
-  return state.size();
+    if (myOSystem->state().saveState(state))
+      state_size = state.size();
+  }
+  return state_size;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -305,9 +306,32 @@ void* StellaLIBRETRO::getVideoBuffer()
 {
   FrameBufferLIBRETRO& frame = static_cast<FrameBufferLIBRETRO&>(myOSystem->frameBuffer());
 
+  if (video_pending)
+  {
+    renderVideo(frame.getRenderSurface(), getVideoPitch());
+    video_pending = false;
+  }
+
   return static_cast<void*>(frame.getRenderSurface());
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaLIBRETRO::renderVideo(void* buffer, uInt32 pitch, uInt32 xstart)
+{
+  // Expand the indexed TIA image through the palette in a single pass
+  const uInt32 width = myOSystem->console().tia().width(), height = getVideoHeight();
+  const uInt8* in = getVideoBufferIndexed() + xstart;
+  const uInt32* palette = getVideoPalette();
+  uInt8* out = static_cast<uInt8*>(buffer);
+
+  for(uInt32 y = 0; y < height; ++y, in += width, out += pitch)
+  {
+    uInt32* row = reinterpret_cast<uInt32*>(out);
+    for(uInt32 x = 0; x < width - xstart; ++x)
+      row[x] = palette[in[x]];
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool StellaLIBRETRO::getVideoNTSC()
 {
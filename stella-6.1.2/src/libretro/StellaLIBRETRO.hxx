@@ -62,7 +62,7 @@ class StellaLIBRETRO
     uInt32 getROMSize() { return rom_size; }
     uInt32 getROMMax() { return 512 * 1024; }
 
-    uInt8* getRAM() { return system_ram; }
+    uInt8* getRAM();
     uInt32 getRAMSize() { return 128; }
 
     size_t getStateSize();
@@ -79,6 +79,12 @@ class StellaLIBRETRO
     bool   getVideoResize();
 
     void*  getVideoBuffer();
+    void   renderVideo(void* buffer, uInt32 pitch, uInt32 xstart = 0);
+
+    // Without TV effects, the TIA image is just the 8-bit frame buffer mapped through the palette
+    bool   getVideoIndexed() { return myOSystem->frameBuffer().tiaSurface().paletteOnly(); }
+    const uInt8*  getVideoBufferIndexed() { return myOSystem->console().tia().frameBuffer(); }
+    const uInt32* getVideoPalette() { return myOSystem->frameBuffer().tiaSurface().rgbPalette().data(); }
     uInt32 getVideoWidth() { return getVideoZoom()==1 ? myOSystem->console().tia().width() : getVideoWidthMax(); }
     uInt32 getVideoHeight() { return myOSystem->console().tia().height(); }
     uInt32 getVideoPitch() { return getVideoWidthMax() * 4; }
@@ -147,15 +153,17 @@ class StellaLIBRETRO
     uInt32 render_width, render_height;
 
     bool video_ready;
+    bool video_pending;
 
     unique_ptr<Int16[]> audio_buffer;
     uInt32 audio_samples;
 
+    // Size of a state of the current console (0 = not measured yet)
+    size_t state_size;
+
     // (31440 rate / 50 Hz) * 16-bit stereo * 1.25x padding
     const uInt32 audio_buffer_max = (31440 / 50 * 4 * 5) / 4;
 
-    uInt8 system_ram[128];
-
   private:
     string video_palette;
     string video_phosphor;
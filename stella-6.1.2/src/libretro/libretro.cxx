@@ -619,7 +619,21 @@ void retro_run()
   //printf("retro_run - %d %d %d - %d\n", stella.getVideoWidth(), stella.getVideoHeight(), stella.getVideoPitch(), stella.getAudioSize() );
 
   if(stella.getVideoReady())
-    video_cb(reinterpret_cast<uInt32*>(stella.getVideoBuffer()) + crop_left, stella.getVideoWidth() - crop_left, stella.getVideoHeight(), stella.getVideoPitch());
+  {
+    unsigned width = stella.getVideoWidth() - crop_left, height = stella.getVideoHeight();
+    struct retro_framebuffer fb = { NULL, width, height, 0, RETRO_PIXEL_FORMAT_XRGB8888, RETRO_MEMORY_ACCESS_WRITE, 0 };
+
+    // without TV effects, map the TIA image straight into the frontend's buffer
+    if(stella.getVideoIndexed() &&
+       environ_cb(RETRO_ENVIRONMENT_GET_CURRENT_SOFTWARE_FRAMEBUFFER, &fb) && fb.data &&
+       fb.format == RETRO_PIXEL_FORMAT_XRGB8888 && fb.width == width && fb.height == height)
+    {
+      stella.renderVideo(fb.data, fb.pitch, crop_left);
+      video_cb(fb.data, width, height, fb.pitch);
+    }
+    else
+      video_cb(reinterpret_cast<uInt32*>(stella.getVideoBuffer()) + crop_left, width, height, stella.getVideoPitch());
+  }
 
   if(stella.getAudioReady())
     audio_batch_cb(stella.getAudioBuffer(), stella.getAudioSize());